@@ -0,0 +1,651 @@
+/**
+ * register blocks as structs (lm3s811)
+ * AN03 shows how p->num reaches a member of a struct through a pointer. A
+ * peripheral is the same thing: a block of 32-bit registers at fixed offsets
+ * from a base address. Describing the block once as a struct of volatile
+ * members and casting the base address to a pointer to it
+ *
+ *		tGPTMRegs *psTimer = (tGPTMRegs *)TIMER0_BASE;
+ *		psTimer->TAILR = ulValue;
+ *
+ * replaces HWREG(ulBase + TIMER_O_TAILR) = ulValue; with the compiler doing
+ * the offset arithmetic. The layouts below follow the LM3S811 datasheet and
+ * are checked against the driverlib offsets at compile time.
+ */
+
+/**
+ * What it changes in the code:
+ * For a single register access the struct form gives the compiler the same
+ * base address and constant offset that HWREG(ulBase + TIMER_O_xxx) does, so
+ * the plain loads and stores are not expected to change; what the struct
+ * form adds is the type of the block and a layout checked once.
+ *
+ * Registers that are written together and sit next to each other (TAMR and
+ * TBMR, PWMnCMPA and PWMnCMPB, RCGC0 and RCGC1) are written with one STRD.
+ * The compiler never merges volatile stores by itself, so HWREG_STRD() does
+ * it explicitly. RegCycleCompare() below times one STRD against two STRs on
+ * the part, and main() shows both counts on the display.
+ *
+ * The drivers here keep the names and arguments of their HWREG versions in
+ * AN04 (timer, interrupt) and in driverlib/pwm.c, so the code size of the
+ * two forms compares function by function:
+ *		arm-none-eabi-gcc -mcpu=cortex-m3 -mthumb -Os -c <file> -o <obj>
+ *		arm-none-eabi-nm -S --size-sort <obj>
+ * for this file, AN04 and pwm.c, reading the sizes of TimerConfigure(),
+ * TimerLoadSet(), TimerIntEnable(), TimerEnable(), IntEnable(),
+ * PWMGenPeriodSet() and PWMPulseWidthSet().
+ */
+
+/** Macros for hardware access, both direct and via the bit-band region. */
+#define HWREG(x)	(*((volatile unsigned long *)(x)))
+
+/**
+ * Stores two values to two adjacent registers with one instruction; the first
+ * value goes to the lower address.
+ */
+#if defined(__GNUC__) && defined(__thumb2__)
+#define HWREG_STRD(pulReg, ulLow, ulHigh)                                    \
+    __asm volatile("strd %1, %2, [%0]" : :                                   \
+                   "r" (pulReg), "r" (ulLow), "r" (ulHigh) : "memory")
+#else
+#define HWREG_STRD(pulReg, ulLow, ulHigh)                                    \
+    do                                                                       \
+    {                                                                        \
+        (pulReg)[0] = (ulLow);                                               \
+        (pulReg)[1] = (ulHigh);                                              \
+    }                                                                        \
+    while(0)
+#endif
+
+/**
+ * Fails to compile if a struct member is not at the offset driverlib uses.
+ * The member may be an array element, so the check is named by line.
+ */
+#define REG_OFFSET_CHECK(tType, sMember, ulOffset)                           \
+    REG_OFFSET_CHECK_LINE(tType, sMember, ulOffset, __LINE__)
+#define REG_OFFSET_CHECK_LINE(tType, sMember, ulOffset, ulLine)              \
+    REG_OFFSET_CHECK_NAME(tType, sMember, ulOffset, ulLine)
+#define REG_OFFSET_CHECK_NAME(tType, sMember, ulOffset, ulLine)              \
+    typedef char tType##_check_##ulLine[                                     \
+        (offsetof(tType, sMember) == (ulOffset)) ? 1 : -1]
+
+/** The system control space starts on the 4 KB boundary below SysTick. */
+#define NVIC_REGS_BASE		(NVIC_ST_CTRL & ~0xFFF)
+
+#include <stddef.h>
+
+/** General-purpose timer module. */
+typedef struct
+{
+    volatile unsigned long CFG;
+    volatile unsigned long TAMR;
+    volatile unsigned long TBMR;
+    volatile unsigned long CTL;
+    volatile unsigned long ulReserved0[2];
+    volatile unsigned long IMR;
+    volatile unsigned long RIS;
+    volatile unsigned long MIS;
+    volatile unsigned long ICR;
+    volatile unsigned long TAILR;
+    volatile unsigned long TBILR;
+    volatile unsigned long TAMATCHR;
+    volatile unsigned long TBMATCHR;
+    volatile unsigned long TAPR;
+    volatile unsigned long TBPR;
+    volatile unsigned long TAPMR;
+    volatile unsigned long TBPMR;
+    volatile unsigned long TAR;
+    volatile unsigned long TBR;
+}
+tGPTMRegs;
+
+/** One generator of the PWM module. */
+typedef struct
+{
+    volatile unsigned long CTL;
+    volatile unsigned long INTEN;
+    volatile unsigned long RIS;
+    volatile unsigned long ISC;
+    volatile unsigned long LOAD;
+    volatile unsigned long COUNT;
+    volatile unsigned long CMPA;
+    volatile unsigned long CMPB;
+    volatile unsigned long GENA;
+    volatile unsigned long GENB;
+    volatile unsigned long DBCTL;
+    volatile unsigned long DBRISE;
+    volatile unsigned long DBFALL;
+    volatile unsigned long ulReserved0[3];
+}
+tPWMGenRegs;
+
+/** PWM module; the LM3S811 has three generators. */
+typedef struct
+{
+    volatile unsigned long CTL;
+    volatile unsigned long SYNC;
+    volatile unsigned long ENABLE;
+    volatile unsigned long INVERT;
+    volatile unsigned long FAULT;
+    volatile unsigned long INTEN;
+    volatile unsigned long RIS;
+    volatile unsigned long ISC;
+    volatile unsigned long STATUS;
+    volatile unsigned long ulReserved0[7];
+    tPWMGenRegs GEN[3];
+}
+tPWMRegs;
+
+/** System control, up to the deep-sleep clock gating registers. */
+typedef struct
+{
+    volatile unsigned long DID0;
+    volatile unsigned long DID1;
+    volatile unsigned long DC0;
+    volatile unsigned long ulReserved0;
+    volatile unsigned long DC1;
+    volatile unsigned long DC2;
+    volatile unsigned long DC3;
+    volatile unsigned long DC4;
+    volatile unsigned long ulReserved1[4];
+    volatile unsigned long PBORCTL;
+    volatile unsigned long LDOPCTL;
+    volatile unsigned long ulReserved2[2];
+    volatile unsigned long SRCR[3];
+    volatile unsigned long ulReserved3;
+    volatile unsigned long RIS;
+    volatile unsigned long IMC;
+    volatile unsigned long MISC;
+    volatile unsigned long RESC;
+    volatile unsigned long RCC;
+    volatile unsigned long PLLCFG;
+    volatile unsigned long ulReserved4[38];
+    volatile unsigned long RCGC[3];
+    volatile unsigned long ulReserved5;
+    volatile unsigned long SCGC[3];
+    volatile unsigned long ulReserved6;
+    volatile unsigned long DCGC[3];
+}
+tSysCtlRegs;
+
+/** SysTick and NVIC, from the start of the system control space. */
+typedef struct
+{
+    volatile unsigned long ulReserved0[4];
+    volatile unsigned long ST_CTRL;
+    volatile unsigned long ST_RELOAD;
+    volatile unsigned long ST_CURRENT;
+    volatile unsigned long ST_CAL;
+    volatile unsigned long ulReserved1[56];
+    volatile unsigned long EN[2];
+    volatile unsigned long ulReserved2[30];
+    volatile unsigned long DIS[2];
+    volatile unsigned long ulReserved3[30];
+    volatile unsigned long PEND[2];
+    volatile unsigned long ulReserved4[30];
+    volatile unsigned long UNPEND[2];
+    volatile unsigned long ulReserved5[30];
+    volatile unsigned long ACTIVE[2];
+    volatile unsigned long ulReserved6[62];
+    volatile unsigned long PRI[16];
+    volatile unsigned long ulReserved7[560];
+    volatile unsigned long CPUID;
+    volatile unsigned long INT_CTRL;
+    volatile unsigned long VTABLE;
+    volatile unsigned long APINT;
+    volatile unsigned long SYS_CTRL;
+    volatile unsigned long CFG_CTRL;
+    volatile unsigned long SYS_PRI[3];
+    volatile unsigned long SYS_HND_CTRL;
+}
+tNVICRegs;
+
+REG_OFFSET_CHECK(tGPTMRegs, TAMR, TIMER_O_TAMR);
+REG_OFFSET_CHECK(tGPTMRegs, TBMR, TIMER_O_TBMR);
+REG_OFFSET_CHECK(tGPTMRegs, CTL, TIMER_O_CTL);
+REG_OFFSET_CHECK(tGPTMRegs, IMR, TIMER_O_IMR);
+REG_OFFSET_CHECK(tGPTMRegs, MIS, TIMER_O_MIS);
+REG_OFFSET_CHECK(tGPTMRegs, ICR, TIMER_O_ICR);
+REG_OFFSET_CHECK(tGPTMRegs, TAILR, TIMER_O_TAILR);
+REG_OFFSET_CHECK(tGPTMRegs, TBILR, TIMER_O_TBILR);
+REG_OFFSET_CHECK(tGPTMRegs, TAR, TIMER_O_TAR);
+REG_OFFSET_CHECK(tGPTMRegs, TBR, TIMER_O_TBR);
+REG_OFFSET_CHECK(tPWMGenRegs, CTL, PWM_O_X_CTL);
+REG_OFFSET_CHECK(tPWMGenRegs, LOAD, PWM_O_X_LOAD);
+REG_OFFSET_CHECK(tPWMGenRegs, CMPA, PWM_O_X_CMPA);
+REG_OFFSET_CHECK(tPWMGenRegs, CMPB, PWM_O_X_CMPB);
+REG_OFFSET_CHECK(tPWMGenRegs, DBFALL, PWM_O_X_DBFALL);
+REG_OFFSET_CHECK(tPWMRegs, ENABLE, PWM_O_ENABLE);
+REG_OFFSET_CHECK(tPWMRegs, STATUS, PWM_O_STATUS);
+REG_OFFSET_CHECK(tPWMRegs, GEN[0], PWM_GEN_0_OFFSET);
+REG_OFFSET_CHECK(tPWMRegs, GEN[1], PWM_GEN_1_OFFSET);
+REG_OFFSET_CHECK(tPWMRegs, GEN[2], PWM_GEN_2_OFFSET);
+REG_OFFSET_CHECK(tSysCtlRegs, DC1, SYSCTL_DC1 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, SRCR[0], SYSCTL_SRCR0 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, RCC, SYSCTL_RCC - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, PLLCFG, SYSCTL_PLLCFG - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, RCGC[0], SYSCTL_RCGC0 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, RCGC[1], SYSCTL_RCGC1 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, RCGC[2], SYSCTL_RCGC2 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, SCGC[0], SYSCTL_SCGC0 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, DCGC[0], SYSCTL_DCGC0 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tSysCtlRegs, DCGC[2], SYSCTL_DCGC2 - SYSCTL_BASE);
+REG_OFFSET_CHECK(tNVICRegs, ST_CTRL, NVIC_ST_CTRL - NVIC_REGS_BASE);
+REG_OFFSET_CHECK(tNVICRegs, EN[0], NVIC_EN0 - NVIC_REGS_BASE);
+REG_OFFSET_CHECK(tNVICRegs, EN[1], NVIC_EN1 - NVIC_REGS_BASE);
+REG_OFFSET_CHECK(tNVICRegs, DIS[0], NVIC_DIS0 - NVIC_REGS_BASE);
+REG_OFFSET_CHECK(tNVICRegs, PRI[0], NVIC_PRI0 - NVIC_REGS_BASE);
+REG_OFFSET_CHECK(tNVICRegs, INT_CTRL, NVIC_INT_CTRL - NVIC_REGS_BASE);
+REG_OFFSET_CHECK(tNVICRegs, SYS_HND_CTRL,
+                 NVIC_SYS_HND_CTRL - NVIC_REGS_BASE);
+
+#define GPTM(ulBase)		((tGPTMRegs *)(ulBase))
+#define PWM(ulBase)			((tPWMRegs *)(ulBase))
+#define SYSCTL				((tSysCtlRegs *)SYSCTL_BASE)
+#define NVIC				((tNVICRegs *)NVIC_REGS_BASE)
+
+/** PWM_GEN_n and PWM_OUT_n are encoded as (generator + 1) << 6. */
+#define PWM_GEN_INDEX(ulGen)	((((ulGen) & 0xC0) >> 6) - 1)
+
+/**
+ * SysCtlPeripheralEnable() - Enables a peripheral.
+ * @ulPeripheral:		the peripheral will be enabled.
+ *
+ * Same as in AN04, indexing the RCGC array instead of g_pulRCGCRegs[].
+ *
+ * Return: none.
+ */
+void SysCtlPeripheralEnable(unsigned long ulPeripheral)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(SysCtlPeripheralValid(ulPeripheral));
+
+    //
+    // Enable this peripheral.
+    //
+    SYSCTL->RCGC[SYSCTL_PERIPH_INDEX(ulPeripheral)] |=
+        SYSCTL_PERIPH_MASK(ulPeripheral);
+}
+
+/**
+ * SysCtlPeripheralEnableMulti() - Enables peripherals in RCGC0 and RCGC1.
+ * @ulRCGC0:		the bits to set in RCGC0.
+ * @ulRCGC1:		the bits to set in RCGC1.
+ *
+ * For start-up code that knows its clock bits; both registers are read, then
+ * written back with a single STRD.
+ *
+ * Return: none.
+ */
+void SysCtlPeripheralEnableMulti(unsigned long ulRCGC0, unsigned long ulRCGC1)
+{
+    tSysCtlRegs *psSys = SYSCTL;
+
+    HWREG_STRD(psSys->RCGC, psSys->RCGC[0] | ulRCGC0,
+               psSys->RCGC[1] | ulRCGC1);
+}
+
+/**
+ * TimerLoadSet() - Set the timer load value.
+ * @ulBase:			the base address of the timer module.
+ * @ulTimer:		specifies the timer(s) to adjust.
+ * @ulValue:		the load value.
+ *
+ * Return:	none.
+ */
+void TimerLoadSet(unsigned long ulBase, unsigned long ulTimer,
+                  unsigned long ulValue)
+{
+    tGPTMRegs *psTimer = GPTM(ulBase);
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(TimerBaseValid(ulBase));
+    ASSERT((ulTimer == TIMER_A) || (ulTimer == TIMER_B) ||
+           (ulTimer == TIMER_BOTH));
+
+    //
+    // Both load registers are adjacent, so TIMER_BOTH is one store.
+    //
+    if(ulTimer == TIMER_BOTH)
+    {
+        HWREG_STRD(&psTimer->TAILR, ulValue, ulValue);
+    }
+    else if(ulTimer & TIMER_A)
+    {
+        psTimer->TAILR = ulValue;
+    }
+    else
+    {
+        psTimer->TBILR = ulValue;
+    }
+}
+
+/**
+ * TimerConfigure() - Configures the timer(s).
+ * @ulBase:			the base address of the timer module.
+ * @ulConfig:		the configuration for the timer.
+ *
+ * Same sequence as in AN04; the two mode registers are written together.
+ *
+ * Return:	none.
+ */
+void TimerConfigure(unsigned long ulBase, unsigned long ulConfig)
+{
+    tGPTMRegs *psTimer = GPTM(ulBase);
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(TimerBaseValid(ulBase));
+    ASSERT((ulConfig == TIMER_CFG_32_BIT_OS) ||
+           (ulConfig == TIMER_CFG_32_BIT_OS_UP) ||
+           (ulConfig == TIMER_CFG_32_BIT_PER) ||
+           (ulConfig == TIMER_CFG_32_BIT_PER_UP) ||
+           (ulConfig == TIMER_CFG_32_RTC) ||
+           ((ulConfig & 0xff000000) == TIMER_CFG_16_BIT_PAIR));
+    ASSERT(((ulConfig & 0xff000000) != TIMER_CFG_16_BIT_PAIR) ||
+           ((((ulConfig & 0x000000ff) == TIMER_CFG_A_ONE_SHOT) ||
+             ((ulConfig & 0x000000ff) == TIMER_CFG_A_ONE_SHOT_UP) ||
+             ((ulConfig & 0x000000ff) == TIMER_CFG_A_PERIODIC) ||
+             ((ulConfig & 0x000000ff) == TIMER_CFG_A_PERIODIC_UP) ||
+             ((ulConfig & 0x000000ff) == TIMER_CFG_A_CAP_COUNT) ||
+             ((ulConfig & 0x000000ff) == TIMER_CFG_A_CAP_TIME) ||
+             ((ulConfig & 0x000000ff) == TIMER_CFG_A_PWM)) &&
+            (((ulConfig & 0x0000ff00) == TIMER_CFG_B_ONE_SHOT) ||
+             ((ulConfig & 0x0000ff00) == TIMER_CFG_B_ONE_SHOT_UP) ||
+             ((ulConfig & 0x0000ff00) == TIMER_CFG_B_PERIODIC) ||
+             ((ulConfig & 0x0000ff00) == TIMER_CFG_B_PERIODIC_UP) ||
+             ((ulConfig & 0x0000ff00) == TIMER_CFG_B_CAP_COUNT) ||
+             ((ulConfig & 0x0000ff00) == TIMER_CFG_B_CAP_TIME) ||
+             ((ulConfig & 0x0000ff00) == TIMER_CFG_B_PWM))));
+
+    //
+    // Disable the timers.
+    //
+    psTimer->CTL &= ~(TIMER_CTL_TAEN | TIMER_CTL_TBEN);
+
+    //
+    // Set the global timer configuration.
+    //
+    psTimer->CFG = ulConfig >> 24;
+
+    //
+    // Set the configuration of the A and B timers.  Note that the B timer
+    // configuration is ignored by the hardware in 32-bit modes.
+    //
+    HWREG_STRD(&psTimer->TAMR, ulConfig & 255, (ulConfig >> 8) & 255);
+}
+
+/**
+ * TimerIntEnable() - Enables individual timer interrupt sources.
+ * @ulBase:			the base address of the timer module.
+ * @ulIntFlags:		the bit mask of the interrupt sources to be enabled.
+ *
+ * Return:	none.
+ */
+void TimerIntEnable(unsigned long ulBase, unsigned long ulIntFlags)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(TimerBaseValid(ulBase));
+
+    GPTM(ulBase)->IMR |= ulIntFlags;
+}
+
+/**
+ * TimerEnable() - Enables the timer(s).
+ * @ulBase:			the base address of the timer module.
+ * @ulTimer:		specifies the timer(s) to enable.
+ *
+ * Return:	none.
+ */
+void TimerEnable(unsigned long ulBase, unsigned long ulTimer)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(TimerBaseValid(ulBase));
+    ASSERT((ulTimer == TIMER_A) || (ulTimer == TIMER_B) ||
+           (ulTimer == TIMER_BOTH));
+
+    GPTM(ulBase)->CTL |= ulTimer & (TIMER_CTL_TAEN | TIMER_CTL_TBEN);
+}
+
+/**
+ * IntEnable() - Enables an interrupt.
+ * @ulInterrupt:	specifies the interrupt to be enabled.
+ *
+ * Return:	none.
+ */
+void IntEnable(unsigned long ulInterrupt)
+{
+    tNVICRegs *psNVIC = NVIC;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulInterrupt < NUM_INTERRUPTS);
+
+    //
+    // The general interrupts are the common case, test for them first.
+    //
+    if(ulInterrupt >= 16)
+    {
+        psNVIC->EN[(ulInterrupt - 16) >> 5] = 1UL << ((ulInterrupt - 16) & 31);
+    }
+    else if(ulInterrupt == FAULT_MPU)
+    {
+        psNVIC->SYS_HND_CTRL |= NVIC_SYS_HND_CTRL_MEM;
+    }
+    else if(ulInterrupt == FAULT_BUS)
+    {
+        psNVIC->SYS_HND_CTRL |= NVIC_SYS_HND_CTRL_BUS;
+    }
+    else if(ulInterrupt == FAULT_USAGE)
+    {
+        psNVIC->SYS_HND_CTRL |= NVIC_SYS_HND_CTRL_USAGE;
+    }
+    else if(ulInterrupt == FAULT_SYSTICK)
+    {
+        psNVIC->ST_CTRL |= NVIC_ST_CTRL_INTEN;
+    }
+}
+
+/**
+ * PWMGenPeriodSet() - Sets the period of a PWM generator.
+ * @ulBase:			the base address of the PWM module.
+ * @ulGen:			the PWM generator to be modified.
+ * @ulPeriod:		the period of the generator in PWM clock ticks.
+ *
+ * Return:	none.
+ */
+void PWMGenPeriodSet(unsigned long ulBase, unsigned long ulGen,
+                     unsigned long ulPeriod)
+{
+    tPWMGenRegs *psGen = &PWM(ulBase)->GEN[PWM_GEN_INDEX(ulGen)];
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == PWM_BASE);
+    ASSERT(PWMGenValid(ulGen));
+
+    //
+    // In up/down count mode the counter counts to the load value and back,
+    // in down count mode it reloads after reaching zero.
+    //
+    if(psGen->CTL & PWM_X_CTL_MODE)
+    {
+        ASSERT((ulPeriod / 2) < 65536);
+        psGen->LOAD = ulPeriod / 2;
+    }
+    else
+    {
+        ASSERT((ulPeriod <= 65536) && (ulPeriod != 0));
+        psGen->LOAD = ulPeriod - 1;
+    }
+}
+
+/**
+ * PWMPulseWidthSet() - Sets the pulse width of a PWM output.
+ * @ulBase:			the base address of the PWM module.
+ * @ulPWMOut:		the PWM output to modify.
+ * @ulWidth:		the width of the positive portion of the pulse.
+ *
+ * Return:	none.
+ */
+void PWMPulseWidthSet(unsigned long ulBase, unsigned long ulPWMOut,
+                      unsigned long ulWidth)
+{
+    tPWMGenRegs *psGen = &PWM(ulBase)->GEN[PWM_GEN_INDEX(ulPWMOut)];
+    unsigned long ulLoad;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == PWM_BASE);
+    ASSERT(PWMOutValid(ulPWMOut));
+
+    if(psGen->CTL & PWM_X_CTL_MODE)
+    {
+        ulWidth /= 2;
+    }
+    ulLoad = psGen->LOAD;
+    ASSERT(ulWidth < ulLoad);
+
+    if(ulPWMOut & 1)
+    {
+        psGen->CMPB = ulLoad - ulWidth;
+    }
+    else
+    {
+        psGen->CMPA = ulLoad - ulWidth;
+    }
+}
+
+/**
+ * PWMGenPulseWidthsSet() - Sets both pulse widths of a generator at once.
+ * @ulBase:			the base address of the PWM module.
+ * @ulGen:			the PWM generator to be modified.
+ * @ulWidthA:		the pulse width of the even output of the generator.
+ * @ulWidthB:		the pulse width of the odd output of the generator.
+ *
+ * Meant for duty cycle updates from the PWM interrupt: one read of CTL and
+ * LOAD and a single STRD to CMPA and CMPB, instead of two calls to
+ * PWMPulseWidthSet().
+ *
+ * Return:	none.
+ */
+void PWMGenPulseWidthsSet(unsigned long ulBase, unsigned long ulGen,
+                          unsigned long ulWidthA, unsigned long ulWidthB)
+{
+    tPWMGenRegs *psGen = &PWM(ulBase)->GEN[PWM_GEN_INDEX(ulGen)];
+    unsigned long ulLoad;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == PWM_BASE);
+    ASSERT(PWMGenValid(ulGen));
+
+    if(psGen->CTL & PWM_X_CTL_MODE)
+    {
+        ulWidthA /= 2;
+        ulWidthB /= 2;
+    }
+    ulLoad = psGen->LOAD;
+    ASSERT((ulWidthA < ulLoad) && (ulWidthB < ulLoad));
+
+    HWREG_STRD(&psGen->CMPA, ulLoad - ulWidthA, ulLoad - ulWidthB);
+}
+
+/**
+ * PWMGenEnable() - Enables the timer/counter for a PWM generator block.
+ * @ulBase:			the base address of the PWM module.
+ * @ulGen:			the PWM generator to be enabled.
+ *
+ * Return:	none.
+ */
+void PWMGenEnable(unsigned long ulBase, unsigned long ulGen)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulBase == PWM_BASE);
+    ASSERT(PWMGenValid(ulGen));
+
+    PWM(ulBase)->GEN[PWM_GEN_INDEX(ulGen)].CTL |= PWM_X_CTL_ENABLE;
+}
+
+/**
+ * RegCycleCompare() - Times two stores against one STRD to adjacent registers.
+ * @pulSeparate:	receives the cycles of two separate stores.
+ * @pulPaired:		receives the cycles of the HWREG_STRD() form.
+ *
+ * Uses the DWT cycle counter of the Cortex-M3. The stores go to the load
+ * registers of TIMER1, which must be clocked and disabled. Interrupts should
+ * be disabled while this runs. The cost of two back-to-back counter reads is
+ * measured first and taken off both results.
+ *
+ * Return:	none.
+ */
+void RegCycleCompare(unsigned long *pulSeparate, unsigned long *pulPaired)
+{
+    tGPTMRegs *psTimer = GPTM(TIMER1_BASE);
+    unsigned long ulStart, ulOverhead;
+
+    //
+    // Enable the trace block and the cycle counter.
+    //
+    HWREG(0xE000EDFC) |= 0x01000000;
+    HWREG(0xE0001000) |= 1;
+
+    ulStart = HWREG(0xE0001004);
+    ulOverhead = HWREG(0xE0001004) - ulStart;
+
+    ulStart = HWREG(0xE0001004);
+    psTimer->TAILR = 0x1000;
+    psTimer->TBILR = 0x2000;
+    *pulSeparate = HWREG(0xE0001004) - ulStart - ulOverhead;
+
+    ulStart = HWREG(0xE0001004);
+    HWREG_STRD(&psTimer->TAILR, 0x1000, 0x2000);
+    *pulPaired = HWREG(0xE0001004) - ulStart - ulOverhead;
+}
+
+/* Runs RegCycleCompare() and shows the cycles of both forms. */
+int main(void)
+{
+    unsigned long ulSeparate, ulPaired;
+    char pcBuffer[24];
+
+    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN |
+                   SYSCTL_XTAL_6MHZ);
+
+    Display96x16x1Init(false);
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_32_BIT_PER);
+
+    //
+    // Show the second of two runs, with the trace block already enabled.
+    //
+    IntMasterDisable();
+    RegCycleCompare(&ulSeparate, &ulPaired);
+    RegCycleCompare(&ulSeparate, &ulPaired);
+    IntMasterEnable();
+
+    usnprintf(pcBuffer, sizeof(pcBuffer), "2x STR: %u", ulSeparate);
+    Display96x16x1StringDraw(pcBuffer, 0, 0);
+    usnprintf(pcBuffer, sizeof(pcBuffer), "STRD:   %u", ulPaired);
+    Display96x16x1StringDraw(pcBuffer, 0, 1);
+
+    while(1)
+    {
+    }
+}
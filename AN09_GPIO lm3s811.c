@@ -0,0 +1,713 @@
+/**
+ * GPIO: batched pin configuration (lm3s811)
+ * AN05 calls GPIOPinTypePWM(GPIO_PORTD_BASE, GPIO_PIN_0 | GPIO_PIN_1). Inside
+ * driverlib that is GPIODirModeSet() plus GPIOPadConfigSet(), ten
+ * read-modify-write cycles on one port: DIR, AFSEL, DR2R, DR4R, DR8R, SLR,
+ * ODR, PUR, PDR and DEN. A board with pins on every port repeats that for
+ * each port and each pin type, mostly rewriting registers with the value
+ * they already hold.
+ */
+
+/**
+ * Batched configuration:
+ * GPIOPinConfigureBatch() takes a table describing every pin group of the
+ * board, folds it into one set mask and one clear mask per register per
+ * port, and then touches each register of each port at most once:
+ * - the GPIO clocks of all ports in the table are enabled with one write to
+ *   RCGC2;
+ * - registers that no entry changes are not read at all, and a register is
+ *   not written back when the new value equals the old one;
+ * - setting a bit in one of DR2R, DR4R and DR8R clears it in the other two,
+ *   and setting a bit in PUR clears it in PDR and the other way round, so
+ *   those registers only need the set half of the masks (the pull registers
+ *   are still cleared for pins configured without a pull).
+ * DEN is written last so a pin only drives once the rest is in place.
+ */
+
+/**
+ * Host model:
+ * With -DHOST_SIM the register accesses go to a model of the five LM3S811
+ * ports that keeps each register of all 40 pins as one packed 64-bit word,
+ * bit (port * 8 + pin). Pad levels are computed for all pins at once from
+ * AFSEL, DIR, DATA, DEN, the peripheral outputs and the external inputs; the
+ * changed bits are handed as rise and fall masks to listeners such as the
+ * timer model, without visiting pins one by one. A PWM model drives PD0 and
+ * PD1 as in AN05, e.g.
+ *		gcc -O2 -DHOST_SIM -x c "AN09_GPIO lm3s811.c" -o gpio
+ */
+
+#define GPIO_NUM_PORTS		5
+
+/** Index of a port in the configuration table, A to E. */
+#define GPIO_PORT_A			0
+#define GPIO_PORT_B			1
+#define GPIO_PORT_C			2
+#define GPIO_PORT_D			3
+#define GPIO_PORT_E			4
+
+typedef struct
+{
+    unsigned char ucPort;
+    unsigned char ucPins;
+    unsigned char ucDirMode;
+    unsigned char ucStrength;
+    unsigned char ucPinType;
+}
+tGPIOPinConfig;
+
+#ifndef HOST_SIM
+
+/** Macros for hardware access, both direct and via the bit-band region. */
+#define HWREG(x)	(*((volatile unsigned long *)(x)))
+
+static const unsigned long g_pulGPIOBase[GPIO_NUM_PORTS] =
+{
+    GPIO_PORTA_BASE, GPIO_PORTB_BASE, GPIO_PORTC_BASE, GPIO_PORTD_BASE,
+    GPIO_PORTE_BASE
+};
+
+#define GPIO_REG_READ(ulPort, ulOffset)                                      \
+    HWREG(g_pulGPIOBase[ulPort] + (ulOffset))
+#define GPIO_REG_WRITE(ulPort, ulOffset, ulValue)                            \
+    (HWREG(g_pulGPIOBase[ulPort] + (ulOffset)) = (ulValue))
+
+#else /* HOST_SIM */
+
+#define ASSERT(x)
+
+#define GPIO_O_DATA			0x00000000
+#define GPIO_O_DIR			0x00000400
+#define GPIO_O_AFSEL		0x00000420
+#define GPIO_O_DR2R			0x00000500
+#define GPIO_O_DR4R			0x00000504
+#define GPIO_O_DR8R			0x00000508
+#define GPIO_O_ODR			0x0000050C
+#define GPIO_O_PUR			0x00000510
+#define GPIO_O_PDR			0x00000514
+#define GPIO_O_SLR			0x00000518
+#define GPIO_O_DEN			0x0000051C
+
+#define GPIO_DIR_MODE_IN	0x00000000
+#define GPIO_DIR_MODE_OUT	0x00000001
+#define GPIO_DIR_MODE_HW	0x00000002
+
+#define GPIO_STRENGTH_2MA	0x00000001
+#define GPIO_STRENGTH_4MA	0x00000002
+#define GPIO_STRENGTH_8MA	0x00000004
+#define GPIO_STRENGTH_8MA_SC	0x0000000C
+
+#define GPIO_PIN_TYPE_STD		0x00000008
+#define GPIO_PIN_TYPE_STD_WPU	0x0000000A
+#define GPIO_PIN_TYPE_STD_WPD	0x0000000C
+#define GPIO_PIN_TYPE_OD		0x00000009
+#define GPIO_PIN_TYPE_ANALOG	0x00000000
+
+unsigned long SimGPIORead(unsigned long ulPort, unsigned long ulOffset);
+void SimGPIOWrite(unsigned long ulPort, unsigned long ulOffset,
+                  unsigned long ulValue);
+
+#define GPIO_REG_READ(ulPort, ulOffset)	SimGPIORead(ulPort, ulOffset)
+#define GPIO_REG_WRITE(ulPort, ulOffset, ulValue)                            \
+    SimGPIOWrite(ulPort, ulOffset, ulValue)
+
+#endif /* HOST_SIM */
+
+/**
+ * Registers in the order they are written by GPIOPinConfigureBatch().
+ */
+#define GPIO_REG_AFSEL		0
+#define GPIO_REG_DIR		1
+#define GPIO_REG_DR2R		2
+#define GPIO_REG_DR4R		3
+#define GPIO_REG_DR8R		4
+#define GPIO_REG_SLR		5
+#define GPIO_REG_ODR		6
+#define GPIO_REG_PUR		7
+#define GPIO_REG_PDR		8
+#define GPIO_REG_DEN		9
+#define GPIO_NUM_REGS		10
+
+static const unsigned short g_pusGPIORegOffset[GPIO_NUM_REGS] =
+{
+    GPIO_O_AFSEL, GPIO_O_DIR, GPIO_O_DR2R, GPIO_O_DR4R, GPIO_O_DR8R,
+    GPIO_O_SLR, GPIO_O_ODR, GPIO_O_PUR, GPIO_O_PDR, GPIO_O_DEN
+};
+
+/**
+ * GPIOPinConfigureBatch() - Configures pins on any number of ports.
+ * @psConfig:		the pin groups, each with a port, pins, a direction mode
+ *					(GPIO_DIR_MODE_xxx), a strength (GPIO_STRENGTH_xxx) and a
+ *					pin type (GPIO_PIN_TYPE_xxx).
+ * @ulCount:		the number of entries in @psConfig.
+ *
+ * Gives the same result as calling GPIODirModeSet() and GPIOPadConfigSet()
+ * for every entry. Later entries win where they overlap earlier ones.
+ *
+ * Return:	none.
+ */
+void GPIOPinConfigureBatch(const tGPIOPinConfig *psConfig,
+                           unsigned long ulCount)
+{
+    unsigned char pucSet[GPIO_NUM_PORTS][GPIO_NUM_REGS];
+    unsigned char pucClear[GPIO_NUM_PORTS][GPIO_NUM_REGS];
+    unsigned long ulPorts, ulPort, ulReg, ulPins, ulOld, ulNew, ulIdx;
+    unsigned long pulSet[GPIO_NUM_REGS];
+
+    ulPorts = 0;
+    for(ulPort = 0; ulPort < GPIO_NUM_PORTS; ulPort++)
+    {
+        for(ulReg = 0; ulReg < GPIO_NUM_REGS; ulReg++)
+        {
+            pucSet[ulPort][ulReg] = 0;
+            pucClear[ulPort][ulReg] = 0;
+        }
+    }
+
+    //
+    // Fold the table into set/clear masks per port and register.
+    //
+    for(ulIdx = 0; ulIdx < ulCount; ulIdx++, psConfig++)
+    {
+        ASSERT(psConfig->ucPort < GPIO_NUM_PORTS);
+        ASSERT((psConfig->ucDirMode == GPIO_DIR_MODE_IN) ||
+               (psConfig->ucDirMode == GPIO_DIR_MODE_OUT) ||
+               (psConfig->ucDirMode == GPIO_DIR_MODE_HW));
+
+        ulPort = psConfig->ucPort;
+        ulPins = psConfig->ucPins;
+        ulPorts |= 1 << ulPort;
+
+        pulSet[GPIO_REG_AFSEL] = psConfig->ucDirMode & GPIO_DIR_MODE_HW;
+        pulSet[GPIO_REG_DIR] = psConfig->ucDirMode & GPIO_DIR_MODE_OUT;
+        pulSet[GPIO_REG_DR2R] = psConfig->ucStrength & 1;
+        pulSet[GPIO_REG_DR4R] = psConfig->ucStrength & 2;
+        pulSet[GPIO_REG_DR8R] = psConfig->ucStrength & 4;
+        pulSet[GPIO_REG_SLR] = psConfig->ucStrength & 8;
+        pulSet[GPIO_REG_ODR] = psConfig->ucPinType & 1;
+        pulSet[GPIO_REG_PUR] = psConfig->ucPinType & 2;
+        pulSet[GPIO_REG_PDR] = psConfig->ucPinType & 4;
+        pulSet[GPIO_REG_DEN] = psConfig->ucPinType & 8;
+
+        for(ulReg = 0; ulReg < GPIO_NUM_REGS; ulReg++)
+        {
+            if(pulSet[ulReg])
+            {
+                pucSet[ulPort][ulReg] |= ulPins;
+                pucClear[ulPort][ulReg] &= ~ulPins;
+            }
+            else
+            {
+                pucSet[ulPort][ulReg] &= ~ulPins;
+                pucClear[ulPort][ulReg] |= ulPins;
+            }
+        }
+    }
+
+    //
+    // Turn on the clock of every port used, in one go.
+    //
+#ifndef HOST_SIM
+    HWREG(SYSCTL_RCGC2) |= ulPorts;
+
+    //
+    // Read it back; the ports need a few clocks before they respond.
+    //
+    ulOld = HWREG(SYSCTL_RCGC2);
+#endif
+
+    for(ulPort = 0; ulPort < GPIO_NUM_PORTS; ulPort++)
+    {
+        if(!(ulPorts & (1 << ulPort)))
+        {
+            continue;
+        }
+
+        //
+        // The hardware clears the other drive registers, and the opposite
+        // pull register, when a bit is set.
+        //
+        pucClear[ulPort][GPIO_REG_DR2R] = 0;
+        pucClear[ulPort][GPIO_REG_DR4R] = 0;
+        pucClear[ulPort][GPIO_REG_DR8R] = 0;
+        pucClear[ulPort][GPIO_REG_PUR] &= ~pucSet[ulPort][GPIO_REG_PDR];
+        pucClear[ulPort][GPIO_REG_PDR] &= ~pucSet[ulPort][GPIO_REG_PUR];
+
+        for(ulReg = 0; ulReg < GPIO_NUM_REGS; ulReg++)
+        {
+            if(!(pucSet[ulPort][ulReg] | pucClear[ulPort][ulReg]))
+            {
+                continue;
+            }
+
+            ulOld = GPIO_REG_READ(ulPort, g_pusGPIORegOffset[ulReg]);
+            ulNew = (ulOld & ~pucClear[ulPort][ulReg]) |
+                    pucSet[ulPort][ulReg];
+            if(ulNew != ulOld)
+            {
+                GPIO_REG_WRITE(ulPort, g_pusGPIORegOffset[ulReg], ulNew);
+            }
+        }
+    }
+}
+
+#ifndef HOST_SIM
+
+/**
+ * The pins of the AN05 PWM example plus the rest of the board, in one table.
+ */
+static const tGPIOPinConfig g_psBoardPins[] =
+{
+    { GPIO_PORT_A, GPIO_PIN_0 | GPIO_PIN_1, GPIO_DIR_MODE_HW,
+      GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD },
+    { GPIO_PORT_B, GPIO_PIN_4, GPIO_DIR_MODE_IN,
+      GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU },
+    { GPIO_PORT_C, GPIO_PIN_5, GPIO_DIR_MODE_OUT,
+      GPIO_STRENGTH_8MA, GPIO_PIN_TYPE_STD },
+    { GPIO_PORT_C, GPIO_PIN_4, GPIO_DIR_MODE_IN,
+      GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU },
+    { GPIO_PORT_D, GPIO_PIN_0 | GPIO_PIN_1, GPIO_DIR_MODE_HW,
+      GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD },
+    { GPIO_PORT_D, GPIO_PIN_4, GPIO_DIR_MODE_HW,
+      GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD },
+};
+
+/* configure all the pins of the board with one call. */
+int main(void)
+{
+    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN |
+                   SYSCTL_XTAL_6MHZ);
+
+    GPIOPinConfigureBatch(g_psBoardPins,
+                          sizeof(g_psBoardPins) / sizeof(g_psBoardPins[0]));
+
+    while(1)
+    {
+    }
+}
+
+#else /* HOST_SIM */
+
+#include <stdio.h>
+#include <time.h>
+
+#define SIM_NUM_LISTENERS	4
+
+typedef void (*tSimEdgeFn)(void *pvData, unsigned long long ullRise,
+                           unsigned long long ullFall,
+                           unsigned long long ullTime);
+
+typedef struct
+{
+    unsigned long long ullMask;
+    tSimEdgeFn pfnEdge;
+    void *pvData;
+}
+tSimListener;
+
+/**
+ * All pins of all ports, bit (port * 8 + pin) of each word.
+ */
+typedef struct
+{
+    unsigned long long pullReg[GPIO_NUM_REGS];
+    unsigned long long ullData;
+    unsigned long long ullPeriph;
+    unsigned long long ullExternal;
+    unsigned long long ullLevel;
+    unsigned long long ullTime;
+
+    unsigned long ulReads;
+    unsigned long ulWrites;
+    unsigned long ulEvents;
+
+    unsigned long ulListeners;
+    tSimListener psListeners[SIM_NUM_LISTENERS];
+}
+tSimGPIO;
+
+static tSimGPIO g_sSimGPIO;
+
+/**
+ * SimGPIOUpdate() - Recomputes every pad and reports the edges.
+ *
+ * Return:	none.
+ */
+static void SimGPIOUpdate(void)
+{
+    tSimGPIO *psGPIO = &g_sSimGPIO;
+    unsigned long long ullAfsel, ullDir, ullLevel, ullChanged, ullRise;
+    unsigned long ulIdx;
+    tSimListener *psListener;
+
+    ullAfsel = psGPIO->pullReg[GPIO_REG_AFSEL];
+    ullDir = psGPIO->pullReg[GPIO_REG_DIR];
+
+    ullLevel = (ullAfsel & psGPIO->ullPeriph) |
+               (~ullAfsel & ullDir & psGPIO->ullData) |
+               (~ullAfsel & ~ullDir & psGPIO->ullExternal);
+    ullLevel &= psGPIO->pullReg[GPIO_REG_DEN];
+
+    ullChanged = ullLevel ^ psGPIO->ullLevel;
+    psGPIO->ullLevel = ullLevel;
+    if(!ullChanged)
+    {
+        return;
+    }
+
+    ullRise = ullChanged & ullLevel;
+    for(ulIdx = 0; ulIdx < psGPIO->ulListeners; ulIdx++)
+    {
+        psListener = &psGPIO->psListeners[ulIdx];
+        if(ullChanged & psListener->ullMask)
+        {
+            psGPIO->ulEvents++;
+            psListener->pfnEdge(psListener->pvData,
+                                ullRise & psListener->ullMask,
+                                ullChanged & ~ullRise & psListener->ullMask,
+                                psGPIO->ullTime);
+        }
+    }
+}
+
+static unsigned long SimGPIORegIndex(unsigned long ulOffset)
+{
+    unsigned long ulReg;
+
+    for(ulReg = 0; ulReg < GPIO_NUM_REGS; ulReg++)
+    {
+        if(g_pusGPIORegOffset[ulReg] == ulOffset)
+        {
+            return(ulReg);
+        }
+    }
+    return(GPIO_NUM_REGS);
+}
+
+unsigned long SimGPIORead(unsigned long ulPort, unsigned long ulOffset)
+{
+    unsigned long ulReg = SimGPIORegIndex(ulOffset);
+
+    g_sSimGPIO.ulReads++;
+    if(ulOffset == (GPIO_O_DATA + 0x3FC))
+    {
+        return((g_sSimGPIO.ullLevel >> (ulPort * 8)) & 0xFF);
+    }
+    if(ulReg == GPIO_NUM_REGS)
+    {
+        return(0);
+    }
+    return((g_sSimGPIO.pullReg[ulReg] >> (ulPort * 8)) & 0xFF);
+}
+
+void SimGPIOWrite(unsigned long ulPort, unsigned long ulOffset,
+                  unsigned long ulValue)
+{
+    unsigned long long *pullReg, ullMask, ullValue;
+    unsigned long ulReg = SimGPIORegIndex(ulOffset);
+
+    g_sSimGPIO.ulWrites++;
+    ullMask = 0xFFULL << (ulPort * 8);
+    ullValue = (unsigned long long)(ulValue & 0xFF) << (ulPort * 8);
+
+    if(ulOffset == (GPIO_O_DATA + 0x3FC))
+    {
+        pullReg = &g_sSimGPIO.ullData;
+    }
+    else if(ulReg == GPIO_NUM_REGS)
+    {
+        return;
+    }
+    else
+    {
+        pullReg = &g_sSimGPIO.pullReg[ulReg];
+
+        //
+        // Setting a drive or pull bit clears it in its siblings.
+        //
+        if((ulReg >= GPIO_REG_DR2R) && (ulReg <= GPIO_REG_DR8R))
+        {
+            g_sSimGPIO.pullReg[GPIO_REG_DR2R] &= ~ullValue;
+            g_sSimGPIO.pullReg[GPIO_REG_DR4R] &= ~ullValue;
+            g_sSimGPIO.pullReg[GPIO_REG_DR8R] &= ~ullValue;
+        }
+        else if(ulReg == GPIO_REG_PUR)
+        {
+            g_sSimGPIO.pullReg[GPIO_REG_PDR] &= ~ullValue;
+        }
+        else if(ulReg == GPIO_REG_PDR)
+        {
+            g_sSimGPIO.pullReg[GPIO_REG_PUR] &= ~ullValue;
+        }
+    }
+
+    *pullReg = (*pullReg & ~ullMask) | ullValue;
+    SimGPIOUpdate();
+}
+
+/**
+ * SimGPIOPeriphDrive() - Sets the peripheral side of any number of pins.
+ * @ullMask:		the pins driven.
+ * @ullLevel:		their new levels.
+ * @ullTime:		the simulation time of the change.
+ *
+ * Return:	none.
+ */
+static void SimGPIOPeriphDrive(unsigned long long ullMask,
+                               unsigned long long ullLevel,
+                               unsigned long long ullTime)
+{
+    g_sSimGPIO.ullTime = ullTime;
+    g_sSimGPIO.ullPeriph = (g_sSimGPIO.ullPeriph & ~ullMask) |
+                           (ullLevel & ullMask);
+    SimGPIOUpdate();
+}
+
+static void SimGPIOListen(unsigned long long ullMask, tSimEdgeFn pfnEdge,
+                          void *pvData)
+{
+    tSimListener *psListener;
+
+    psListener = &g_sSimGPIO.psListeners[g_sSimGPIO.ulListeners++];
+    psListener->ullMask = ullMask;
+    psListener->pfnEdge = pfnEdge;
+    psListener->pvData = pvData;
+}
+
+#define SIM_PIN(ulPort, ulPin)	(1ULL << ((ulPort) * 8 + (ulPin)))
+
+/**
+ * PWM generator model in count-down mode: both outputs go high at load and
+ * low at their compare match, AN05 style. Only the edge times are computed.
+ */
+typedef struct
+{
+    unsigned long ulLoad;
+    unsigned long ulCmpA;
+    unsigned long ulCmpB;
+    unsigned long long ullPinA;
+    unsigned long long ullPinB;
+}
+tSimPWMGen;
+
+static void SimPWMRun(const tSimPWMGen *psGen, unsigned long ulPeriods)
+{
+    unsigned long long ullStart, ullBoth;
+    unsigned long ulPeriod, ulFallA, ulFallB;
+
+    ullBoth = psGen->ullPinA | psGen->ullPinB;
+    ulPeriod = psGen->ulLoad + 1;
+    ulFallA = psGen->ulLoad - psGen->ulCmpA;
+    ulFallB = psGen->ulLoad - psGen->ulCmpB;
+
+    for(ullStart = g_sSimGPIO.ullTime; ulPeriods; ulPeriods--)
+    {
+        SimGPIOPeriphDrive(ullBoth, ullBoth, ullStart);
+        if(ulFallA == ulFallB)
+        {
+            SimGPIOPeriphDrive(ullBoth, 0, ullStart + ulFallA);
+        }
+        else if(ulFallA < ulFallB)
+        {
+            SimGPIOPeriphDrive(psGen->ullPinA, 0, ullStart + ulFallA);
+            SimGPIOPeriphDrive(psGen->ullPinB, 0, ullStart + ulFallB);
+        }
+        else
+        {
+            SimGPIOPeriphDrive(psGen->ullPinB, 0, ullStart + ulFallB);
+            SimGPIOPeriphDrive(psGen->ullPinA, 0, ullStart + ulFallA);
+        }
+        ullStart += ulPeriod;
+    }
+    g_sSimGPIO.ullTime = ullStart;
+}
+
+/**
+ * Timer model in edge-time capture mode on one pin: period and high time of
+ * the last full cycle.
+ */
+typedef struct
+{
+    unsigned long long ullPin;
+    unsigned long long ullRise;
+    unsigned long ulPeriod;
+    unsigned long ulHigh;
+    unsigned long ulEdges;
+}
+tSimCapture;
+
+static void SimCaptureEdge(void *pvData, unsigned long long ullRise,
+                           unsigned long long ullFall,
+                           unsigned long long ullTime)
+{
+    tSimCapture *psCap = pvData;
+
+    if(ullRise & psCap->ullPin)
+    {
+        if(psCap->ulEdges)
+        {
+            psCap->ulPeriod = (unsigned long)(ullTime - psCap->ullRise);
+        }
+        psCap->ullRise = ullTime;
+        psCap->ulEdges++;
+    }
+    if(ullFall & psCap->ullPin)
+    {
+        psCap->ulHigh = (unsigned long)(ullTime - psCap->ullRise);
+        psCap->ulEdges++;
+    }
+}
+
+/**
+ * SimGPIOPinType() - What one GPIOPinTypeXxx() call does in driverlib:
+ * GPIODirModeSet() followed by GPIOPadConfigSet(), for comparison.
+ */
+static void SimGPIOPinType(unsigned long ulPort, unsigned long ulPins,
+                           unsigned long ulDirMode, unsigned long ulStrength,
+                           unsigned long ulPinType)
+{
+    unsigned long ulReg, pulSet[GPIO_NUM_REGS], ulValue;
+
+    pulSet[GPIO_REG_DIR] = ulDirMode & GPIO_DIR_MODE_OUT;
+    pulSet[GPIO_REG_AFSEL] = ulDirMode & GPIO_DIR_MODE_HW;
+    pulSet[GPIO_REG_DR2R] = ulStrength & 1;
+    pulSet[GPIO_REG_DR4R] = ulStrength & 2;
+    pulSet[GPIO_REG_DR8R] = ulStrength & 4;
+    pulSet[GPIO_REG_SLR] = ulStrength & 8;
+    pulSet[GPIO_REG_ODR] = ulPinType & 1;
+    pulSet[GPIO_REG_PUR] = ulPinType & 2;
+    pulSet[GPIO_REG_PDR] = ulPinType & 4;
+    pulSet[GPIO_REG_DEN] = ulPinType & 8;
+
+    for(ulReg = 0; ulReg < GPIO_NUM_REGS; ulReg++)
+    {
+        ulValue = GPIO_REG_READ(ulPort, g_pusGPIORegOffset[ulReg]);
+        GPIO_REG_WRITE(ulPort, g_pusGPIORegOffset[ulReg],
+                       pulSet[ulReg] ? (ulValue | ulPins) :
+                                       (ulValue & ~ulPins));
+    }
+}
+
+static const tGPIOPinConfig g_psBoardPins[] =
+{
+    { GPIO_PORT_A, 0x03, GPIO_DIR_MODE_HW, GPIO_STRENGTH_2MA,
+      GPIO_PIN_TYPE_STD },
+    { GPIO_PORT_B, 0x10, GPIO_DIR_MODE_IN, GPIO_STRENGTH_2MA,
+      GPIO_PIN_TYPE_STD_WPU },
+    { GPIO_PORT_C, 0x20, GPIO_DIR_MODE_OUT, GPIO_STRENGTH_8MA,
+      GPIO_PIN_TYPE_STD },
+    { GPIO_PORT_C, 0x10, GPIO_DIR_MODE_IN, GPIO_STRENGTH_2MA,
+      GPIO_PIN_TYPE_STD_WPU },
+    { GPIO_PORT_D, 0x03, GPIO_DIR_MODE_HW, GPIO_STRENGTH_2MA,
+      GPIO_PIN_TYPE_STD },
+    { GPIO_PORT_D, 0x10, GPIO_DIR_MODE_HW, GPIO_STRENGTH_2MA,
+      GPIO_PIN_TYPE_STD },
+};
+
+#define SIM_NUM_BOARD_PINS	(sizeof(g_psBoardPins) / sizeof(g_psBoardPins[0]))
+
+static void SimGPIOReset(void)
+{
+    unsigned long ulReg;
+
+    for(ulReg = 0; ulReg < GPIO_NUM_REGS; ulReg++)
+    {
+        g_sSimGPIO.pullReg[ulReg] = 0;
+    }
+
+    //
+    // Out of reset every pin has 2 mA drive.
+    //
+    g_sSimGPIO.pullReg[GPIO_REG_DR2R] = ~0ULL;
+    g_sSimGPIO.ullData = 0;
+    g_sSimGPIO.ullLevel = 0;
+    g_sSimGPIO.ulReads = 0;
+    g_sSimGPIO.ulWrites = 0;
+}
+
+static double SimSeconds(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return(sTime.tv_sec + sTime.tv_nsec * 1e-9);
+}
+
+int main(void)
+{
+    unsigned long long pullSingle[GPIO_NUM_REGS];
+    unsigned long ulIdx, ulErrors;
+    tSimPWMGen sGen;
+    tSimCapture sCap0, sCap1;
+    double dStart;
+
+    ulErrors = 0;
+
+    //
+    // The board table one GPIOPinTypeXxx() call per entry ...
+    //
+    SimGPIOReset();
+    for(ulIdx = 0; ulIdx < SIM_NUM_BOARD_PINS; ulIdx++)
+    {
+        SimGPIOPinType(g_psBoardPins[ulIdx].ucPort,
+                       g_psBoardPins[ulIdx].ucPins,
+                       g_psBoardPins[ulIdx].ucDirMode,
+                       g_psBoardPins[ulIdx].ucStrength,
+                       g_psBoardPins[ulIdx].ucPinType);
+    }
+    printf("per call: %3lu reads %3lu writes\n", g_sSimGPIO.ulReads,
+           g_sSimGPIO.ulWrites);
+    for(ulIdx = 0; ulIdx < GPIO_NUM_REGS; ulIdx++)
+    {
+        pullSingle[ulIdx] = g_sSimGPIO.pullReg[ulIdx];
+    }
+
+    //
+    // ... and batched, which must end in the same state.
+    //
+    SimGPIOReset();
+    GPIOPinConfigureBatch(g_psBoardPins, SIM_NUM_BOARD_PINS);
+    printf("batched:  %3lu reads %3lu writes\n", g_sSimGPIO.ulReads,
+           g_sSimGPIO.ulWrites);
+    for(ulIdx = 0; ulIdx < GPIO_NUM_REGS; ulIdx++)
+    {
+        if(pullSingle[ulIdx] != g_sSimGPIO.pullReg[ulIdx])
+        {
+            printf("register %lu differs\n", ulIdx);
+            ulErrors++;
+        }
+    }
+
+    //
+    // AN05: PWM0 25% and PWM1 75% on PD0 and PD1, seen by two captures.
+    //
+    sGen.ulLoad = 399;
+    sGen.ulCmpA = 299;
+    sGen.ulCmpB = 99;
+    sGen.ullPinA = SIM_PIN(GPIO_PORT_D, 0);
+    sGen.ullPinB = SIM_PIN(GPIO_PORT_D, 1);
+    sCap0.ullPin = sGen.ullPinA;
+    sCap1.ullPin = sGen.ullPinB;
+    sCap0.ulEdges = sCap1.ulEdges = 0;
+    SimGPIOListen(sCap0.ullPin, SimCaptureEdge, &sCap0);
+    SimGPIOListen(sCap1.ullPin, SimCaptureEdge, &sCap1);
+
+    g_sSimGPIO.ulEvents = 0;
+    dStart = SimSeconds();
+    SimPWMRun(&sGen, 10000000);
+    dStart = SimSeconds() - dStart;
+
+    printf("PWM0 period %lu high %lu, PWM1 period %lu high %lu\n",
+           sCap0.ulPeriod, sCap0.ulHigh, sCap1.ulPeriod, sCap1.ulHigh);
+    printf("%lu edge events, %.1f ns each\n", g_sSimGPIO.ulEvents,
+           dStart * 1e9 / g_sSimGPIO.ulEvents);
+
+    if((sCap0.ulPeriod != 400) || (sCap0.ulHigh != 100) ||
+       (sCap1.ulPeriod != 400) || (sCap1.ulHigh != 300))
+    {
+        ulErrors++;
+    }
+
+    return(ulErrors ? 1 : 0);
+}
+
+#endif /* HOST_SIM */
@@ -0,0 +1,620 @@
+/**
+ * peripheral clock manager (lm3s811)
+ * AN01 and AN04 turn peripheral clocks on with SysCtlPeripheralEnable() and
+ * never turn them off, so every block that was used once keeps drawing
+ * current in run mode (RCGCn), sleep mode (SCGCn) and deep-sleep mode
+ * (DCGCn). Hand-written SysCtlPeripheralDisable() calls do not work either
+ * once two drivers share a block, e.g. the GPIO port D pins of AN05 and
+ * AN06.
+ */
+
+/**
+ * Reference counts and lazy gating:
+ * Each driver brackets its use of a block with ClkMgrAcquire() and
+ * ClkMgrRelease(). The first acquire turns the clock on before returning,
+ * since the caller is about to touch the registers. The last release only
+ * records the time; the clock stays on for a grace period, so a driver that
+ * releases and re-acquires in a loop does not toggle the gate every time.
+ * ClkMgrPoll(), called from a periodic tick, gates whatever has been idle for
+ * longer than the grace period.
+ *
+ * All changes found in one poll are applied together: one write per
+ * RCGC/SCGC/DCGC register that changes, three at most, instead of one
+ * read-modify-write per peripheral. Each peripheral can ask to stay clocked
+ * in sleep or deep-sleep while acquired; those bits follow RCGC.
+ *
+ * Only the bits of registered peripherals are ever changed: every write is a
+ * read-modify-write under the mask of managed bits, so a clock enabled with
+ * SysCtlPeripheralEnable() after ClkMgrInit() stays on. The clock of a
+ * registered peripheral must from then on only be switched through the
+ * manager; ClkMgrPoll() asserts that.
+ *
+ * For each peripheral the manager also accumulates how many ticks it has
+ * been clocked, which is what the power budget is checked against.
+ *
+ * Build with -DHOST_SIM for a run against a model of the gating registers,
+ * e.g.
+ *		gcc -O2 -DHOST_SIM -x c "AN10_clockmgr lm3s811.c" -o clkmgr
+ */
+
+/** Macros for hardware access, both direct and via the bit-band region. */
+#define HWREG(x)	(*((volatile unsigned long *)(x)))
+
+#ifdef HOST_SIM
+#define ASSERT(x)
+
+/** On the target these come from driverlib/sysctl.h. */
+#define SYSCTL_PERIPH_PWM		0x00100010
+#define SYSCTL_PERIPH_ADC		0x00100001
+#define SYSCTL_PERIPH_UART0		0x10000001
+#define SYSCTL_PERIPH_UART1		0x10000002
+#define SYSCTL_PERIPH_TIMER0	0x10100001
+#define SYSCTL_PERIPH_TIMER1	0x10100002
+#define SYSCTL_PERIPH_GPIOD		0x20000008
+
+/** On the target these come from driverlib/sysctl.c, as in AN01 and AN04. */
+#define SYSCTL_PERIPH_INDEX(a)	(((a) >> 28) & 0xf)
+#define SYSCTL_PERIPH_MASK(a)	(((a) & 0xffff) << (((a) & 0x001f0000) >> 16))
+#endif
+
+#define CLKMGR_NUM_REGS		3
+#define CLKMGR_NUM_PERIPH	8
+
+/** Flags for ClkMgrRegister(). */
+#define CLKMGR_SLEEP		0x00000001
+#define CLKMGR_DEEP_SLEEP	0x00000002
+
+typedef struct
+{
+    unsigned long ulPeripheral;
+    unsigned long ulFlags;
+    unsigned long ulRefCount;
+    unsigned long ulReleased;
+    unsigned long ulEnabled;
+    unsigned long ulClockedTicks;
+}
+tClkMgrPeriph;
+
+typedef struct
+{
+    unsigned long ulNow;
+    unsigned long ulGrace;
+    unsigned long ulCount;
+    unsigned long pulManaged[CLKMGR_NUM_REGS];
+    unsigned long pulRun[CLKMGR_NUM_REGS];
+    unsigned long pulSleep[CLKMGR_NUM_REGS];
+    unsigned long pulDeepSleep[CLKMGR_NUM_REGS];
+    unsigned long ulWrites;
+    tClkMgrPeriph psPeriph[CLKMGR_NUM_PERIPH];
+}
+tClkMgr;
+
+static tClkMgr g_sClkMgr;
+
+#ifndef HOST_SIM
+
+static const unsigned long g_pulRCGC[CLKMGR_NUM_REGS] =
+{
+    SYSCTL_RCGC0, SYSCTL_RCGC1, SYSCTL_RCGC2
+};
+static const unsigned long g_pulSCGC[CLKMGR_NUM_REGS] =
+{
+    SYSCTL_SCGC0, SYSCTL_SCGC1, SYSCTL_SCGC2
+};
+static const unsigned long g_pulDCGC[CLKMGR_NUM_REGS] =
+{
+    SYSCTL_DCGC0, SYSCTL_DCGC1, SYSCTL_DCGC2
+};
+
+#define CLKMGR_RCGC(ulReg)		HWREG(g_pulRCGC[ulReg])
+#define CLKMGR_SCGC(ulReg)		HWREG(g_pulSCGC[ulReg])
+#define CLKMGR_DCGC(ulReg)		HWREG(g_pulDCGC[ulReg])
+#define CLKMGR_INT_DISABLE()	IntMasterDisable()
+#define CLKMGR_INT_RESTORE(bWasDisabled)                                     \
+    do                                                                       \
+    {                                                                        \
+        if(!(bWasDisabled))                                                  \
+        {                                                                    \
+            IntMasterEnable();                                               \
+        }                                                                    \
+    }                                                                        \
+    while(0)
+
+#else /* HOST_SIM */
+
+static unsigned long g_pulSimRCGC[CLKMGR_NUM_REGS];
+static unsigned long g_pulSimSCGC[CLKMGR_NUM_REGS];
+static unsigned long g_pulSimDCGC[CLKMGR_NUM_REGS];
+
+#define CLKMGR_RCGC(ulReg)		g_pulSimRCGC[ulReg]
+#define CLKMGR_SCGC(ulReg)		g_pulSimSCGC[ulReg]
+#define CLKMGR_DCGC(ulReg)		g_pulSimDCGC[ulReg]
+#define CLKMGR_INT_DISABLE()	0
+#define CLKMGR_INT_RESTORE(bWasDisabled)	((void)(bWasDisabled))
+
+#endif /* HOST_SIM */
+
+/**
+ * ClkMgrInit() - Starts the clock manager.
+ * @ulGraceTicks:	how many ClkMgrPoll() ticks a released peripheral stays
+ *					clocked.
+ *
+ * No clock is touched until a peripheral is registered; clocks that are not
+ * registered are left alone, whenever they are enabled.
+ *
+ * Return:	none.
+ */
+void ClkMgrInit(unsigned long ulGraceTicks)
+{
+    unsigned long ulReg;
+
+    g_sClkMgr.ulNow = 0;
+    g_sClkMgr.ulGrace = ulGraceTicks;
+    g_sClkMgr.ulCount = 0;
+    g_sClkMgr.ulWrites = 0;
+
+    for(ulReg = 0; ulReg < CLKMGR_NUM_REGS; ulReg++)
+    {
+        g_sClkMgr.pulManaged[ulReg] = 0;
+        g_sClkMgr.pulRun[ulReg] = 0;
+        g_sClkMgr.pulSleep[ulReg] = 0;
+        g_sClkMgr.pulDeepSleep[ulReg] = 0;
+    }
+}
+
+/**
+ * ClkMgrRegister() - Puts a peripheral under the manager.
+ * @ulPeripheral:	the peripheral, SYSCTL_PERIPH_xxx.
+ * @ulFlags:		CLKMGR_SLEEP and/or CLKMGR_DEEP_SLEEP to keep it clocked
+ *					in those modes while acquired.
+ *
+ * A clock that is already on is taken over as released, so it is gated after
+ * the grace period unless acquired. Call before the tick runs ClkMgrPoll().
+ *
+ * Return:	the handle for ClkMgrAcquire() and ClkMgrRelease().
+ */
+unsigned long ClkMgrRegister(unsigned long ulPeripheral, unsigned long ulFlags)
+{
+    tClkMgrPeriph *psPeriph;
+    unsigned long ulReg, ulMask;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(g_sClkMgr.ulCount < CLKMGR_NUM_PERIPH);
+    ASSERT(SYSCTL_PERIPH_INDEX(ulPeripheral) < CLKMGR_NUM_REGS);
+
+    ulReg = SYSCTL_PERIPH_INDEX(ulPeripheral);
+    ulMask = SYSCTL_PERIPH_MASK(ulPeripheral);
+
+    psPeriph = &g_sClkMgr.psPeriph[g_sClkMgr.ulCount];
+    psPeriph->ulPeripheral = ulPeripheral;
+    psPeriph->ulFlags = ulFlags;
+    psPeriph->ulRefCount = 0;
+    psPeriph->ulReleased = g_sClkMgr.ulNow;
+    psPeriph->ulEnabled = (CLKMGR_RCGC(ulReg) & ulMask) ? 1 : 0;
+    psPeriph->ulClockedTicks = 0;
+
+    //
+    // From here on the manager owns these bits; start from what the
+    // hardware has.
+    //
+    g_sClkMgr.pulManaged[ulReg] |= ulMask;
+    g_sClkMgr.pulRun[ulReg] |= CLKMGR_RCGC(ulReg) & ulMask;
+    g_sClkMgr.pulSleep[ulReg] |= CLKMGR_SCGC(ulReg) & ulMask;
+    g_sClkMgr.pulDeepSleep[ulReg] |= CLKMGR_DCGC(ulReg) & ulMask;
+
+    return(g_sClkMgr.ulCount++);
+}
+
+/**
+ * ClkMgrAcquire() - Takes a reference on a peripheral clock.
+ * @ulHandle:		the handle from ClkMgrRegister().
+ *
+ * The clock is running when this returns. Safe to call from interrupts and
+ * with interrupts disabled.
+ *
+ * Return:	none.
+ */
+void ClkMgrAcquire(unsigned long ulHandle)
+{
+    tClkMgrPeriph *psPeriph = &g_sClkMgr.psPeriph[ulHandle];
+    unsigned long ulReg, ulMask;
+    int bWasDisabled;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulHandle < g_sClkMgr.ulCount);
+
+    bWasDisabled = CLKMGR_INT_DISABLE();
+
+    if((psPeriph->ulRefCount++ == 0) && !psPeriph->ulEnabled)
+    {
+        //
+        // The caller is about to use the block, so this one cannot wait for
+        // the next poll.
+        //
+        ulReg = SYSCTL_PERIPH_INDEX(psPeriph->ulPeripheral);
+        ulMask = SYSCTL_PERIPH_MASK(psPeriph->ulPeripheral);
+
+        g_sClkMgr.pulRun[ulReg] |= ulMask;
+        CLKMGR_RCGC(ulReg) |= ulMask;
+        g_sClkMgr.ulWrites++;
+        psPeriph->ulEnabled = 1;
+
+        //
+        // Read it back; the block needs a few clocks before it responds.
+        //
+        (void)CLKMGR_RCGC(ulReg);
+    }
+
+    CLKMGR_INT_RESTORE(bWasDisabled);
+}
+
+/**
+ * ClkMgrRelease() - Drops a reference on a peripheral clock.
+ * @ulHandle:		the handle from ClkMgrRegister().
+ *
+ * The clock is gated by a later ClkMgrPoll() once the grace period is over
+ * and nobody has acquired it again. Safe to call from interrupts.
+ *
+ * Return:	none.
+ */
+void ClkMgrRelease(unsigned long ulHandle)
+{
+    tClkMgrPeriph *psPeriph = &g_sClkMgr.psPeriph[ulHandle];
+    int bWasDisabled;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulHandle < g_sClkMgr.ulCount);
+    ASSERT(psPeriph->ulRefCount != 0);
+
+    bWasDisabled = CLKMGR_INT_DISABLE();
+
+    if(--psPeriph->ulRefCount == 0)
+    {
+        psPeriph->ulReleased = g_sClkMgr.ulNow;
+    }
+
+    CLKMGR_INT_RESTORE(bWasDisabled);
+}
+
+/**
+ * ClkMgrPoll() - Advances time and applies pending gating, in one batch.
+ *
+ * Call from a periodic tick. Computes the wanted state of the managed bits in
+ * all three register sets from the reference counts and writes only the
+ * registers that differ, keeping their other bits.
+ *
+ * Return:	none.
+ */
+void ClkMgrPoll(void)
+{
+    unsigned long pulRun[CLKMGR_NUM_REGS], pulSleep[CLKMGR_NUM_REGS];
+    unsigned long pulDeepSleep[CLKMGR_NUM_REGS];
+    unsigned long ulIdx, ulReg, ulMask;
+    tClkMgrPeriph *psPeriph;
+    int bWasDisabled;
+
+    bWasDisabled = CLKMGR_INT_DISABLE();
+
+    g_sClkMgr.ulNow++;
+
+    for(ulReg = 0; ulReg < CLKMGR_NUM_REGS; ulReg++)
+    {
+        //
+        // A managed clock switched behind the manager's back would be
+        // overwritten below.
+        //
+        ASSERT((CLKMGR_RCGC(ulReg) & g_sClkMgr.pulManaged[ulReg]) ==
+               g_sClkMgr.pulRun[ulReg]);
+
+        pulRun[ulReg] = g_sClkMgr.pulRun[ulReg];
+        pulSleep[ulReg] = g_sClkMgr.pulSleep[ulReg];
+        pulDeepSleep[ulReg] = g_sClkMgr.pulDeepSleep[ulReg];
+    }
+
+    for(ulIdx = 0; ulIdx < g_sClkMgr.ulCount; ulIdx++)
+    {
+        psPeriph = &g_sClkMgr.psPeriph[ulIdx];
+        ulReg = SYSCTL_PERIPH_INDEX(psPeriph->ulPeripheral);
+        ulMask = SYSCTL_PERIPH_MASK(psPeriph->ulPeripheral);
+
+        if(psPeriph->ulEnabled)
+        {
+            psPeriph->ulClockedTicks++;
+        }
+
+        if(psPeriph->ulRefCount)
+        {
+            pulRun[ulReg] |= ulMask;
+            if(psPeriph->ulFlags & CLKMGR_SLEEP)
+            {
+                pulSleep[ulReg] |= ulMask;
+            }
+            if(psPeriph->ulFlags & CLKMGR_DEEP_SLEEP)
+            {
+                pulDeepSleep[ulReg] |= ulMask;
+            }
+        }
+        else if(psPeriph->ulEnabled &&
+                ((g_sClkMgr.ulNow - psPeriph->ulReleased) > g_sClkMgr.ulGrace))
+        {
+            pulRun[ulReg] &= ~ulMask;
+            pulSleep[ulReg] &= ~ulMask;
+            pulDeepSleep[ulReg] &= ~ulMask;
+            psPeriph->ulEnabled = 0;
+        }
+        else if(!psPeriph->ulEnabled)
+        {
+            //
+            // Not in use: make sure the sleep modes do not keep it on
+            // either.
+            //
+            pulSleep[ulReg] &= ~ulMask;
+            pulDeepSleep[ulReg] &= ~ulMask;
+        }
+    }
+
+    for(ulReg = 0; ulReg < CLKMGR_NUM_REGS; ulReg++)
+    {
+        ulMask = g_sClkMgr.pulManaged[ulReg];
+
+        if(pulRun[ulReg] != g_sClkMgr.pulRun[ulReg])
+        {
+            g_sClkMgr.pulRun[ulReg] = pulRun[ulReg];
+            CLKMGR_RCGC(ulReg) = (CLKMGR_RCGC(ulReg) & ~ulMask) | pulRun[ulReg];
+            g_sClkMgr.ulWrites++;
+        }
+        if(pulSleep[ulReg] != g_sClkMgr.pulSleep[ulReg])
+        {
+            g_sClkMgr.pulSleep[ulReg] = pulSleep[ulReg];
+            CLKMGR_SCGC(ulReg) = (CLKMGR_SCGC(ulReg) & ~ulMask) |
+                                 pulSleep[ulReg];
+            g_sClkMgr.ulWrites++;
+        }
+        if(pulDeepSleep[ulReg] != g_sClkMgr.pulDeepSleep[ulReg])
+        {
+            g_sClkMgr.pulDeepSleep[ulReg] = pulDeepSleep[ulReg];
+            CLKMGR_DCGC(ulReg) = (CLKMGR_DCGC(ulReg) & ~ulMask) |
+                                 pulDeepSleep[ulReg];
+            g_sClkMgr.ulWrites++;
+        }
+    }
+
+    CLKMGR_INT_RESTORE(bWasDisabled);
+}
+
+/**
+ * ClkMgrClockedTicks() - How long a peripheral has been clocked.
+ * @ulHandle:		the handle from ClkMgrRegister().
+ *
+ * Return:	the number of ClkMgrPoll() ticks the clock was on.
+ */
+unsigned long ClkMgrClockedTicks(unsigned long ulHandle)
+{
+    return(g_sClkMgr.psPeriph[ulHandle].ulClockedTicks);
+}
+
+#ifndef HOST_SIM
+
+static unsigned long g_ulClkTimer0;
+
+/**
+ * The 1 ms tick of the clock manager.
+ */
+void SysTickIntHandler(void)
+{
+    ClkMgrPoll();
+}
+
+/* the timer of AN04, clocked only while a measurement runs. */
+int main(void)
+{
+    unsigned long ulLoop;
+
+    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN |
+                   SYSCTL_XTAL_6MHZ);
+
+    //
+    // Gate a released peripheral after 20 ms.
+    //
+    ClkMgrInit(20);
+    g_ulClkTimer0 = ClkMgrRegister(SYSCTL_PERIPH_TIMER0, 0);
+
+    SysTickPeriodSet(SysCtlClockGet() / 1000);
+    SysTickIntEnable();
+    SysTickEnable();
+    IntMasterEnable();
+
+    while(1)
+    {
+        ClkMgrAcquire(g_ulClkTimer0);
+        TimerConfigure(TIMER0_BASE, TIMER_CFG_32_BIT_OS);
+        TimerLoadSet(TIMER0_BASE, TIMER_A, SysCtlClockGet() / 100);
+        TimerEnable(TIMER0_BASE, TIMER_A);
+        while(!(TimerIntStatus(TIMER0_BASE, false) & TIMER_TIMA_TIMEOUT))
+        {
+        }
+        TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+        ClkMgrRelease(g_ulClkTimer0);
+
+        //
+        // Timer 0 is gated during the pause.
+        //
+        for(ulLoop = 0; ulLoop < 1000000; ulLoop++)
+        {
+        }
+    }
+}
+
+#else /* HOST_SIM */
+
+#include <stdio.h>
+
+/**
+ * Host run:
+ * Three drivers share port D and the timers over 10000 ticks. The check is
+ * that an acquired peripheral is always clocked, that the total number of
+ * register writes stays well below one per acquire/release pair, and that
+ * the clocked time is close to the time in use plus the grace periods.
+ *
+ * The gating registers themselves are checked every tick: a registered but
+ * unused UART0 never gets a clock bit, a UART1 enabled behind the manager
+ * keeps its bit, and the managed bits always match the manager's state. The
+ * ADC is on before the manager starts and is gated after the grace period.
+ */
+
+/**
+ * SimClockIsOn() - Whether a peripheral has its bit in a gating register set.
+ */
+static unsigned long SimClockIsOn(unsigned long *pulRegs,
+                                  unsigned long ulPeripheral)
+{
+    return((pulRegs[SYSCTL_PERIPH_INDEX(ulPeripheral)] &
+            SYSCTL_PERIPH_MASK(ulPeripheral)) ? 1 : 0);
+}
+
+int main(void)
+{
+    unsigned long ulPWM, ulTimer0, ulTimer1, ulGPIOD, ulUART, ulADC;
+    unsigned long ulTick, ulPairs, ulErrors, ulInUse, ulReg;
+
+    //
+    // The ADC was left on by the start-up code.
+    //
+    g_pulSimRCGC[SYSCTL_PERIPH_INDEX(SYSCTL_PERIPH_ADC)] |=
+        SYSCTL_PERIPH_MASK(SYSCTL_PERIPH_ADC);
+
+    ClkMgrInit(5);
+    ulPWM = ClkMgrRegister(SYSCTL_PERIPH_PWM, CLKMGR_SLEEP);
+    ulTimer0 = ClkMgrRegister(SYSCTL_PERIPH_TIMER0, 0);
+    ulTimer1 = ClkMgrRegister(SYSCTL_PERIPH_TIMER1, 0);
+    ulGPIOD = ClkMgrRegister(SYSCTL_PERIPH_GPIOD, CLKMGR_SLEEP);
+    ulUART = ClkMgrRegister(SYSCTL_PERIPH_UART0, 0);
+    ulADC = ClkMgrRegister(SYSCTL_PERIPH_ADC, 0);
+
+    ulPairs = 0;
+    ulErrors = 0;
+    ulInUse = 0;
+
+    for(ulTick = 0; ulTick < 10000; ulTick++)
+    {
+        //
+        // PWM output (with its GPIO port) runs for the first half only.
+        //
+        if(ulTick == 0)
+        {
+            ClkMgrAcquire(ulPWM);
+            ClkMgrAcquire(ulGPIOD);
+        }
+        if(ulTick == 5000)
+        {
+            ClkMgrRelease(ulPWM);
+            ClkMgrRelease(ulGPIOD);
+        }
+
+        //
+        // A capture on port D every 100 ticks for 10 ticks; it shares the
+        // port with the PWM.
+        //
+        if((ulTick % 100) == 0)
+        {
+            ClkMgrAcquire(ulTimer0);
+            ClkMgrAcquire(ulGPIOD);
+            ulPairs++;
+        }
+        if((ulTick % 100) == 10)
+        {
+            ClkMgrRelease(ulTimer0);
+            ClkMgrRelease(ulGPIOD);
+        }
+        if(((ulTick % 100) < 10) &&
+           !SimClockIsOn(g_pulSimRCGC, SYSCTL_PERIPH_TIMER0))
+        {
+            ulErrors++;
+        }
+        ulInUse += (ulTick % 100) < 10;
+
+        //
+        // A short timer job every other tick, inside the grace period.
+        //
+        if(ulTick & 1)
+        {
+            ClkMgrAcquire(ulTimer1);
+            ClkMgrRelease(ulTimer1);
+            ulPairs++;
+        }
+
+        //
+        // Another driver enables UART1 with SysCtlPeripheralEnable().
+        //
+        if(ulTick == 2500)
+        {
+            g_pulSimRCGC[SYSCTL_PERIPH_INDEX(SYSCTL_PERIPH_UART1)] |=
+                SYSCTL_PERIPH_MASK(SYSCTL_PERIPH_UART1);
+        }
+
+        ClkMgrPoll();
+
+        if(SimClockIsOn(g_pulSimRCGC, SYSCTL_PERIPH_UART0) ||
+           SimClockIsOn(g_pulSimSCGC, SYSCTL_PERIPH_UART0) ||
+           SimClockIsOn(g_pulSimDCGC, SYSCTL_PERIPH_UART0))
+        {
+            ulErrors++;
+        }
+        if((ulTick >= 2500) &&
+           !SimClockIsOn(g_pulSimRCGC, SYSCTL_PERIPH_UART1))
+        {
+            ulErrors++;
+        }
+        for(ulReg = 0; ulReg < CLKMGR_NUM_REGS; ulReg++)
+        {
+            if(((g_pulSimRCGC[ulReg] & g_sClkMgr.pulManaged[ulReg]) !=
+                g_sClkMgr.pulRun[ulReg]) ||
+               ((g_pulSimSCGC[ulReg] & g_sClkMgr.pulManaged[ulReg]) !=
+                g_sClkMgr.pulSleep[ulReg]) ||
+               ((g_pulSimDCGC[ulReg] & g_sClkMgr.pulManaged[ulReg]) !=
+                g_sClkMgr.pulDeepSleep[ulReg]))
+            {
+                ulErrors++;
+            }
+        }
+    }
+
+    //
+    // The UART was registered and never used: never clocked. The ADC was
+    // taken over running and gated after the grace period.
+    //
+    if((ClkMgrClockedTicks(ulUART) != 0) ||
+       SimClockIsOn(g_pulSimRCGC, SYSCTL_PERIPH_ADC) ||
+       (ClkMgrClockedTicks(ulADC) > 10))
+    {
+        ulErrors++;
+    }
+
+    printf("%lu acquire/release pairs, %lu gating register writes\n",
+           ulPairs, g_sClkMgr.ulWrites);
+    printf("clocked ticks: PWM %lu, GPIOD %lu, TIMER0 %lu (in use %lu), "
+           "TIMER1 %lu, UART0 %lu\n", ClkMgrClockedTicks(ulPWM),
+           ClkMgrClockedTicks(ulGPIOD), ClkMgrClockedTicks(ulTimer0),
+           ulInUse, ClkMgrClockedTicks(ulTimer1), ClkMgrClockedTicks(ulUART));
+    printf("ADC clocked ticks after take-over %lu\n", ClkMgrClockedTicks(ulADC));
+    printf("RCGC0 %08lx RCGC1 %08lx RCGC2 %08lx SCGC0 %08lx SCGC2 %08lx\n",
+           g_pulSimRCGC[0], g_pulSimRCGC[1], g_pulSimRCGC[2],
+           g_pulSimSCGC[0], g_pulSimSCGC[2]);
+
+    if(g_sClkMgr.ulWrites * 4 > ulPairs)
+    {
+        ulErrors++;
+    }
+
+    printf("errors %lu\n", ulErrors);
+
+    return(ulErrors ? 1 : 0);
+}
+
+#endif /* HOST_SIM */
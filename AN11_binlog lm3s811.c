@@ -0,0 +1,785 @@
+/**
+ * deferred binary logging (lm3s811)
+ * The function pointer example of AN03 prints through printf(). On the part
+ * a printf-style call parses the format string and converts every number to
+ * text for every message, and it is usually not re-entrant, so it cannot be
+ * used from an ISR at all.
+ *
+ * The formatting does not have to happen on the part. A log call only needs
+ * to record which format string it used and the raw argument words; a host
+ * tool that has the same format strings can produce the text later.
+ */
+
+/**
+ * Format string IDs:
+ * BINLOG0() to BINLOG3() place their format string in the section
+ * "binlog_fmt", aligned to 4 bytes, and use its address as the ID. The
+ * section is given an address range of its own in the linker script and is
+ * marked INFO, so it stays in the ELF file but takes no flash:
+ *
+ *		binlog_fmt 0xF0000000 (INFO) : { KEEP(*(binlog_fmt)) }
+ *
+ * The host decoder extracts that section, e.g. with
+ *		arm-none-eabi-objcopy -O binary -j binlog_fmt fw.axf fmt.bin
+ * and finds the string of an ID at offset (ID - 0xF0000000). Only integer
+ * conversions (%d %u %x %X %c) can be used, with flags, width, precision and
+ * an optional l; every argument is a 32-bit word on the part. The decoder
+ * checks each format before using it and reports anything else, %s or %f
+ * included, as a bad record.
+ */
+
+/**
+ * Record layout and the buffer:
+ * A record is one header word, the ID with the argument count in its two low
+ * bits, followed by up to three argument words. Space in g_sBinLog is
+ * reserved with a compare-and-swap of the head index, LDREX/STREX on the
+ * Cortex-M3, so a log call preempted by an ISR that logs too just retries;
+ * interrupts are never disabled. The arguments are written first and the
+ * header last, and the reader stops at a header that is still zero, so it
+ * never sees a half written record. A full buffer drops the new record and
+ * counts it.
+ *
+ * The reader, BinLogRead(), runs at task level and copies whole records out
+ * (to the UART, or the debugger reads g_sBinLog directly).
+ */
+
+/**
+ * Stream framing:
+ * On the UART the records go out in frames, built by BinLogFrameRead():
+ *
+ *		BINLOG_SYNC
+ *		number of record words n, and ~n in the upper half
+ *		number of records dropped since reset
+ *		n words of records
+ *
+ * A decoder that attaches in the middle of the stream skips words until it
+ * finds the sync word followed by a length word that checks out, and it can
+ * tell how many records were lost from the change of the dropped count.
+ *
+ * Build with -DHOST_SIM for the decoder and a self test,
+ *		gcc -O2 -DHOST_SIM -x c "AN11_binlog lm3s811.c" -o binlog
+ *		./binlog dump.bin fmt.bin 0xF0000000
+ * decodes a little endian dump of the UART stream against the format table.
+ */
+
+/** Size of the log buffer in words, must be a power of two. */
+#define BINLOG_BUF_WORDS	512
+#define BINLOG_BUF_MASK		(BINLOG_BUF_WORDS - 1)
+
+/** Frame header: sync word, length word, dropped count. */
+#define BINLOG_SYNC			0xB10C5A5A
+#define BINLOG_FRAME_HDR	3
+
+/** Keep the compiler from moving the header store before the arguments. */
+#define BINLOG_BARRIER()	__asm volatile("" : : : "memory")
+
+typedef struct
+{
+    volatile unsigned long ulHead;
+    volatile unsigned long ulTail;
+    volatile unsigned long ulDropped;
+    volatile unsigned long pulBuf[BINLOG_BUF_WORDS];
+}
+tBinLog;
+
+/**
+ * Not static, so the debugger can find it by name.
+ */
+tBinLog g_sBinLog;
+
+#define BINLOG_FMT(pcFmt)                                                    \
+    ({                                                                       \
+        static const char __attribute__((section("binlog_fmt"), aligned(4),  \
+                                         used)) pcBinLogFmt[] = pcFmt;       \
+        pcBinLogFmt;                                                         \
+    })
+
+#define BINLOG0(pcFmt)                                                       \
+    BinLog0(BINLOG_FMT(pcFmt))
+#define BINLOG1(pcFmt, ulArg0)                                               \
+    BinLog1(BINLOG_FMT(pcFmt), (unsigned long)(ulArg0))
+#define BINLOG2(pcFmt, ulArg0, ulArg1)                                       \
+    BinLog2(BINLOG_FMT(pcFmt), (unsigned long)(ulArg0),                      \
+            (unsigned long)(ulArg1))
+#define BINLOG3(pcFmt, ulArg0, ulArg1, ulArg2)                               \
+    BinLog3(BINLOG_FMT(pcFmt), (unsigned long)(ulArg0),                      \
+            (unsigned long)(ulArg1), (unsigned long)(ulArg2))
+
+/**
+ * BinLogReserve() - Claims buffer space for one record.
+ * @ulWords:		the size of the record, header included.
+ *
+ * Return:	the index of the header word, or ~0 if the buffer is full.
+ */
+static inline unsigned long BinLogReserve(unsigned long ulWords)
+{
+    unsigned long ulHead;
+
+    do
+    {
+        ulHead = g_sBinLog.ulHead;
+        if((ulHead + ulWords - g_sBinLog.ulTail) > BINLOG_BUF_WORDS)
+        {
+            __sync_fetch_and_add(&g_sBinLog.ulDropped, 1);
+            return(~0UL);
+        }
+    }
+    while(!__sync_bool_compare_and_swap(&g_sBinLog.ulHead, ulHead,
+                                        ulHead + ulWords));
+
+    return(ulHead);
+}
+
+/**
+ * BinLogCommit() - Publishes a record by writing its header.
+ * @ulIdx:			the index returned by BinLogReserve().
+ * @pcFmt:			the format string in the binlog_fmt section.
+ * @ulArgs:			the number of arguments, 0 to 3.
+ *
+ * Return:	none.
+ */
+static inline void BinLogCommit(unsigned long ulIdx, const char *pcFmt,
+                                unsigned long ulArgs)
+{
+    BINLOG_BARRIER();
+    g_sBinLog.pulBuf[ulIdx & BINLOG_BUF_MASK] = (unsigned long)pcFmt | ulArgs;
+}
+
+void BinLog0(const char *pcFmt)
+{
+    unsigned long ulIdx = BinLogReserve(1);
+
+    if(ulIdx != ~0UL)
+    {
+        BinLogCommit(ulIdx, pcFmt, 0);
+    }
+}
+
+void BinLog1(const char *pcFmt, unsigned long ulArg0)
+{
+    unsigned long ulIdx = BinLogReserve(2);
+
+    if(ulIdx != ~0UL)
+    {
+        g_sBinLog.pulBuf[(ulIdx + 1) & BINLOG_BUF_MASK] = ulArg0;
+        BinLogCommit(ulIdx, pcFmt, 1);
+    }
+}
+
+void BinLog2(const char *pcFmt, unsigned long ulArg0, unsigned long ulArg1)
+{
+    unsigned long ulIdx = BinLogReserve(3);
+
+    if(ulIdx != ~0UL)
+    {
+        g_sBinLog.pulBuf[(ulIdx + 1) & BINLOG_BUF_MASK] = ulArg0;
+        g_sBinLog.pulBuf[(ulIdx + 2) & BINLOG_BUF_MASK] = ulArg1;
+        BinLogCommit(ulIdx, pcFmt, 2);
+    }
+}
+
+void BinLog3(const char *pcFmt, unsigned long ulArg0, unsigned long ulArg1,
+             unsigned long ulArg2)
+{
+    unsigned long ulIdx = BinLogReserve(4);
+
+    if(ulIdx != ~0UL)
+    {
+        g_sBinLog.pulBuf[(ulIdx + 1) & BINLOG_BUF_MASK] = ulArg0;
+        g_sBinLog.pulBuf[(ulIdx + 2) & BINLOG_BUF_MASK] = ulArg1;
+        g_sBinLog.pulBuf[(ulIdx + 3) & BINLOG_BUF_MASK] = ulArg2;
+        BinLogCommit(ulIdx, pcFmt, 3);
+    }
+}
+
+/**
+ * BinLogRead() - Moves complete records out of the buffer.
+ * @pulOut:			receives the records, header and argument words.
+ * @ulMax:			the size of @pulOut in words.
+ *
+ * Stops at the first record that is reserved but not yet committed, or that
+ * does not fit in @pulOut. Must only be called from one context.
+ *
+ * Return:	the number of words written to @pulOut.
+ */
+unsigned long BinLogRead(unsigned long *pulOut, unsigned long ulMax)
+{
+    unsigned long ulTail, ulHead, ulHeader, ulWords, ulIdx, ulCount;
+
+    ulTail = g_sBinLog.ulTail;
+    ulHead = g_sBinLog.ulHead;
+    ulCount = 0;
+
+    while(ulTail != ulHead)
+    {
+        ulHeader = g_sBinLog.pulBuf[ulTail & BINLOG_BUF_MASK];
+        ulWords = (ulHeader & 3) + 1;
+        if((ulHeader == 0) || ((ulCount + ulWords) > ulMax))
+        {
+            break;
+        }
+        BINLOG_BARRIER();
+
+        //
+        // Copy the record and clear it, so the slot reads as uncommitted
+        // the next time round.
+        //
+        for(ulIdx = 0; ulIdx < ulWords; ulIdx++)
+        {
+            pulOut[ulCount++] = g_sBinLog.pulBuf[ulTail & BINLOG_BUF_MASK];
+            g_sBinLog.pulBuf[ulTail & BINLOG_BUF_MASK] = 0;
+            ulTail++;
+        }
+    }
+
+    BINLOG_BARRIER();
+    g_sBinLog.ulTail = ulTail;
+
+    return(ulCount);
+}
+
+/**
+ * BinLogFrameRead() - Moves complete records out of the buffer as a frame.
+ * @pulOut:			receives the frame header and the records.
+ * @ulMax:			the size of @pulOut in words, more than BINLOG_FRAME_HDR.
+ *
+ * Must only be called from the context that calls BinLogRead().
+ *
+ * Return:	the number of words written to @pulOut, 0 if there was nothing
+ *			to send.
+ */
+unsigned long BinLogFrameRead(unsigned long *pulOut, unsigned long ulMax)
+{
+    unsigned long ulCount;
+
+    ulCount = BinLogRead(pulOut + BINLOG_FRAME_HDR, ulMax - BINLOG_FRAME_HDR);
+    if(ulCount == 0)
+    {
+        return(0);
+    }
+
+    pulOut[0] = BINLOG_SYNC;
+    pulOut[1] = ulCount | ((~ulCount & 0xFFFF) << 16);
+    pulOut[2] = g_sBinLog.ulDropped;
+
+    return(ulCount + BINLOG_FRAME_HDR);
+}
+
+#ifndef HOST_SIM
+
+/**
+ * Drains the log to UART0 in frames of little endian words, four bytes each.
+ */
+static void BinLogFlush(void)
+{
+    unsigned long pulWords[BINLOG_FRAME_HDR + 16], ulCount, ulIdx;
+
+    while((ulCount = BinLogFrameRead(pulWords, BINLOG_FRAME_HDR + 16)) != 0)
+    {
+        for(ulIdx = 0; ulIdx < ulCount; ulIdx++)
+        {
+            UARTCharPut(UART0_BASE, pulWords[ulIdx] & 0xFF);
+            UARTCharPut(UART0_BASE, (pulWords[ulIdx] >> 8) & 0xFF);
+            UARTCharPut(UART0_BASE, (pulWords[ulIdx] >> 16) & 0xFF);
+            UARTCharPut(UART0_BASE, pulWords[ulIdx] >> 24);
+        }
+    }
+}
+
+static unsigned long g_ulTicks;
+
+void Timer0AIntHandler(void)
+{
+    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+
+    BINLOG2("T0 tick %u, TAR 0x%08x\n", ++g_ulTicks,
+            HWREG(TIMER0_BASE + TIMER_O_TAR));
+}
+
+void say_hello(unsigned long ulWho)
+{
+    BINLOG1("hello %u\n", ulWho);
+}
+
+/* AN03 with deferred logging, and AN04's timer logging from its ISR. */
+int main(void)
+{
+    void (*f)(unsigned long ulWho) = say_hello;
+
+    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN |
+                   SYSCTL_XTAL_6MHZ);
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+    UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 115200,
+                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
+                         UART_CONFIG_PAR_NONE));
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+    TimerConfigure(TIMER0_BASE, TIMER_CFG_32_BIT_PER);
+    TimerLoadSet(TIMER0_BASE, TIMER_A, SysCtlClockGet() / 100);
+    IntEnable(INT_TIMER0A);
+    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+    IntMasterEnable();
+    TimerEnable(TIMER0_BASE, TIMER_A);
+
+    f(42);
+
+    while(1)
+    {
+        BinLogFlush();
+    }
+}
+
+#else /* HOST_SIM */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * BinLogFormat() - Prints one record through its format string.
+ * @pFile:			where the text goes.
+ * @pcFmt:			the format string of the record.
+ * @pulArgs:		the argument words of the record.
+ * @ulArgs:			the number of argument words.
+ *
+ * The format is checked completely before anything is printed: only the
+ * conversions of the file header are allowed, the l modifier is dropped since
+ * the arguments were 32-bit words on the part, and the number of conversions
+ * must match the number of arguments.
+ *
+ * Return:	0 if the record was printed, 1 if its format is not usable.
+ */
+static unsigned long BinLogFormat(FILE *pFile, const char *pcFmt,
+                                  const unsigned long *pulArgs,
+                                  unsigned long ulArgs)
+{
+    char pcSpec[16];
+    const char *pcChar;
+    unsigned long ulPass, ulUsed, ulLen;
+
+    for(ulPass = 0; ulPass < 2; ulPass++)
+    {
+        ulUsed = 0;
+        for(pcChar = pcFmt; *pcChar; pcChar++)
+        {
+            if(*pcChar != '%')
+            {
+                if(ulPass)
+                {
+                    fputc(*pcChar, pFile);
+                }
+                continue;
+            }
+
+            pcChar++;
+            if(*pcChar == '%')
+            {
+                if(ulPass)
+                {
+                    fputc('%', pFile);
+                }
+                continue;
+            }
+
+            //
+            // Copy flags, width and precision, then the conversion without
+            // the l modifier.
+            //
+            ulLen = 0;
+            pcSpec[ulLen++] = '%';
+            while(*pcChar && strchr("-+ #0", *pcChar) && (ulLen < 6))
+            {
+                pcSpec[ulLen++] = *pcChar++;
+            }
+            while((*pcChar >= '0') && (*pcChar <= '9') && (ulLen < 10))
+            {
+                pcSpec[ulLen++] = *pcChar++;
+            }
+            if(*pcChar == '.')
+            {
+                pcSpec[ulLen++] = *pcChar++;
+                while((*pcChar >= '0') && (*pcChar <= '9') && (ulLen < 14))
+                {
+                    pcSpec[ulLen++] = *pcChar++;
+                }
+            }
+            if(*pcChar == 'l')
+            {
+                pcChar++;
+            }
+            if(!*pcChar || !strchr("duxXc", *pcChar) || (ulUsed >= ulArgs))
+            {
+                return(1);
+            }
+            pcSpec[ulLen++] = *pcChar;
+            pcSpec[ulLen] = 0;
+
+            if(ulPass && ((*pcChar == 'd') || (*pcChar == 'c')))
+            {
+                fprintf(pFile, pcSpec, (int)(unsigned int)pulArgs[ulUsed]);
+            }
+            else if(ulPass)
+            {
+                fprintf(pFile, pcSpec, (unsigned int)pulArgs[ulUsed]);
+            }
+            ulUsed++;
+        }
+
+        if(ulUsed != ulArgs)
+        {
+            return(1);
+        }
+    }
+
+    return(0);
+}
+
+/**
+ * BinLogDecode() - Formats records with the format table of the firmware.
+ * @pulWords:		the records, as read by BinLogRead().
+ * @ulCount:		the number of words in @pulWords.
+ * @pcTable:		the contents of the binlog_fmt section.
+ * @ulTableSize:	the size of @pcTable in bytes.
+ * @ulTableBase:	the address of the binlog_fmt section.
+ * @pFile:			where the text goes.
+ *
+ * Return:	the number of records that could not be decoded.
+ */
+unsigned long BinLogDecode(const unsigned long *pulWords,
+                           unsigned long ulCount, const char *pcTable,
+                           unsigned long ulTableSize,
+                           unsigned long ulTableBase, FILE *pFile)
+{
+    unsigned long ulIdx, ulArgs, ulOffset, ulBad;
+
+    ulBad = 0;
+    for(ulIdx = 0; ulIdx < ulCount; ulIdx += ulArgs + 1)
+    {
+        ulArgs = pulWords[ulIdx] & 3;
+        ulOffset = (pulWords[ulIdx] & ~3UL) - ulTableBase;
+        if((ulOffset >= ulTableSize) || ((ulIdx + ulArgs) >= ulCount) ||
+           !memchr(pcTable + ulOffset, 0, ulTableSize - ulOffset))
+        {
+            //
+            // Not a header; try the next word.
+            //
+            fprintf(pFile, "<bad record 0x%08lx>\n", pulWords[ulIdx]);
+            ulBad++;
+            ulArgs = 0;
+        }
+        else if(BinLogFormat(pFile, pcTable + ulOffset, pulWords + ulIdx + 1,
+                             ulArgs))
+        {
+            //
+            // A known record with a format the decoder cannot use; its
+            // length is still known.
+            //
+            fprintf(pFile, "<bad record 0x%08lx>\n", pulWords[ulIdx]);
+            ulBad++;
+        }
+    }
+
+    return(ulBad);
+}
+
+/**
+ * BinLogDecodeStream() - Decodes the framed stream sent by BinLogFlush().
+ * @pulWords:		the stream, starting anywhere.
+ * @ulCount:		the number of words in @pulWords.
+ * @pcTable:		the contents of the binlog_fmt section.
+ * @ulTableSize:	the size of @pcTable in bytes.
+ * @ulTableBase:	the address of the binlog_fmt section.
+ * @pFile:			where the text goes.
+ *
+ * Words outside a valid frame are skipped and reported, so are records the
+ * part dropped between two frames.
+ *
+ * Return:	the number of records that could not be decoded.
+ */
+unsigned long BinLogDecodeStream(const unsigned long *pulWords,
+                                 unsigned long ulCount, const char *pcTable,
+                                 unsigned long ulTableSize,
+                                 unsigned long ulTableBase, FILE *pFile)
+{
+    unsigned long ulIdx, ulSkipped, ulWords, ulDropped, ulBad;
+
+    ulBad = 0;
+    ulSkipped = 0;
+    ulDropped = 0;
+    ulIdx = 0;
+    while(ulIdx < ulCount)
+    {
+        //
+        // A frame starts with the sync word and a length word that carries
+        // its own complement.
+        //
+        ulWords = 0;
+        if((ulIdx + BINLOG_FRAME_HDR) <= ulCount)
+        {
+            ulWords = pulWords[ulIdx + 1] & 0xFFFF;
+            if((pulWords[ulIdx] != BINLOG_SYNC) ||
+               ((pulWords[ulIdx + 1] >> 16) != (~ulWords & 0xFFFF)) ||
+               ((ulIdx + BINLOG_FRAME_HDR + ulWords) > ulCount))
+            {
+                ulWords = 0;
+            }
+        }
+        if(ulWords == 0)
+        {
+            ulSkipped++;
+            ulIdx++;
+            continue;
+        }
+
+        if(ulSkipped)
+        {
+            fprintf(pFile, "<out of sync, %lu words skipped>\n", ulSkipped);
+            ulSkipped = 0;
+        }
+        if(pulWords[ulIdx + 2] != ulDropped)
+        {
+            fprintf(pFile, "<%lu records dropped>\n",
+                    (pulWords[ulIdx + 2] - ulDropped) & 0xFFFFFFFF);
+            ulDropped = pulWords[ulIdx + 2];
+        }
+
+        ulBad += BinLogDecode(pulWords + ulIdx + BINLOG_FRAME_HDR, ulWords,
+                              pcTable, ulTableSize, ulTableBase, pFile);
+        ulIdx += BINLOG_FRAME_HDR + ulWords;
+    }
+
+    if(ulSkipped)
+    {
+        fprintf(pFile, "<out of sync, %lu words skipped>\n", ulSkipped);
+    }
+
+    return(ulBad);
+}
+
+/**
+ * Decodes a dump taken from the part: little endian words in @argv[1], the
+ * binlog_fmt section in @argv[2], and its address in @argv[3].
+ */
+static int BinLogDecodeFiles(char *argv[])
+{
+    static unsigned long pulWords[1 << 20];
+    static char pcTable[1 << 20];
+    unsigned char pucWord[4];
+    unsigned long ulCount, ulSize;
+    FILE *pDump, *pTable;
+
+    pDump = fopen(argv[1], "rb");
+    pTable = fopen(argv[2], "rb");
+    if(!pDump || !pTable)
+    {
+        fprintf(stderr, "cannot open %s or %s\n", argv[1], argv[2]);
+        return(2);
+    }
+
+    for(ulCount = 0; (ulCount < (1 << 20)) &&
+                     (fread(pucWord, 4, 1, pDump) == 1); ulCount++)
+    {
+        pulWords[ulCount] = pucWord[0] | (pucWord[1] << 8) |
+                            (pucWord[2] << 16) |
+                            ((unsigned long)pucWord[3] << 24);
+    }
+    ulSize = fread(pcTable, 1, sizeof(pcTable) - 1, pTable);
+    pcTable[ulSize] = 0;
+
+    fclose(pDump);
+    fclose(pTable);
+
+    return(BinLogDecodeStream(pulWords, ulCount, pcTable, ulSize,
+                              strtoul(argv[3], 0, 0), stdout) ? 1 : 0);
+}
+
+/**
+ * The host build has the same section; GNU ld provides its bounds.
+ */
+extern const char __start_binlog_fmt[];
+extern const char __stop_binlog_fmt[];
+
+static double SimSeconds(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return(sTime.tv_sec + sTime.tv_nsec * 1e-9);
+}
+
+/**
+ * SimDecode() - Decodes records or a stream into a string.
+ *
+ * Return:	the number of bad records.
+ */
+static unsigned long SimDecode(const unsigned long *pulWords,
+                               unsigned long ulCount, unsigned long bStream,
+                               char *pcText, unsigned long ulSize)
+{
+    unsigned long ulBad, ulLen;
+    FILE *pFile;
+
+    pFile = tmpfile();
+    if(bStream)
+    {
+        ulBad = BinLogDecodeStream(pulWords, ulCount, __start_binlog_fmt,
+                                   __stop_binlog_fmt - __start_binlog_fmt,
+                                   (unsigned long)__start_binlog_fmt, pFile);
+    }
+    else
+    {
+        ulBad = BinLogDecode(pulWords, ulCount, __start_binlog_fmt,
+                             __stop_binlog_fmt - __start_binlog_fmt,
+                             (unsigned long)__start_binlog_fmt, pFile);
+    }
+    rewind(pFile);
+    ulLen = fread(pcText, 1, ulSize - 1, pFile);
+    pcText[ulLen] = 0;
+    fclose(pFile);
+
+    return(ulBad);
+}
+
+int main(int argc, char *argv[])
+{
+    static unsigned long pulWords[BINLOG_BUF_WORDS];
+    static unsigned long pulStream[2 * BINLOG_BUF_WORDS];
+    static char pcStreamText[8192];
+    unsigned long ulCount, ulIdx, ulOuter, ulErrors, ulLoop, ulLines;
+    char pcText[256];
+    char *pcLine;
+    double dStart, dLog, dPrintf;
+
+    if(argc == 4)
+    {
+        return(BinLogDecodeFiles(argv));
+    }
+
+    ulErrors = 0;
+
+    //
+    // Plain records, decoded against the host's own format table.
+    //
+    BINLOG0("boot\n");
+    BINLOG1("hello %u\n", 42);
+    BINLOG3("T%u: period %u, duty %u%%\n", 0, 400, 25);
+
+    //
+    // A record preempted between reserving and committing: nothing after
+    // it may be read before it is committed.
+    //
+    ulOuter = BinLogReserve(2);
+    BINLOG2("isr %u 0x%x\n", 7, 0xBEEF);
+    if(BinLogRead(pulWords, BINLOG_BUF_WORDS) != 7)
+    {
+        ulErrors++;
+    }
+    if(BinLogRead(pulWords + 7, BINLOG_BUF_WORDS - 7) != 0)
+    {
+        ulErrors++;
+    }
+    g_sBinLog.pulBuf[(ulOuter + 1) & BINLOG_BUF_MASK] = 99;
+    BinLogCommit(ulOuter, BINLOG_FMT("outer %u\n"), 1);
+    ulCount = 7 + BinLogRead(pulWords + 7, BINLOG_BUF_WORDS - 7);
+
+    ulErrors += SimDecode(pulWords, ulCount, 0, pcText, sizeof(pcText));
+    fputs(pcText, stdout);
+    if(strcmp(pcText, "boot\nhello 42\nT0: period 400, duty 25%\n"
+                      "outer 99\nisr 7 0xbeef\n") != 0)
+    {
+        ulErrors++;
+    }
+
+    //
+    // The l modifier is natural with unsigned long arguments and works;
+    // conversions that need more than the argument word are bad records,
+    // and so is a count of conversions that does not match the record.
+    //
+    BINLOG3("%lu %ld %08lX\n", 4000000000UL, -3L, 0xCAFEUL);
+    BINLOG1("name %s\n", 0x1000);
+    BINLOG1("%5.2f\n", 1);
+    BINLOG1("%u %u\n", 1);
+    BINLOG2("%-4d|%c\n", 7, 'x');
+    ulCount = BinLogRead(pulWords, BINLOG_BUF_WORDS);
+    if((SimDecode(pulWords, ulCount, 0, pcText, sizeof(pcText)) != 3) ||
+       (strncmp(pcText, "4000000000 -3 0000CAFE\n<bad record", 34) != 0) ||
+       !strstr(pcText, ">\n7   |x\n"))
+    {
+        ulErrors++;
+    }
+    fputs(pcText, stdout);
+
+    //
+    // Overflow drops records and counts them.
+    //
+    for(ulLoop = 0; ulLoop < BINLOG_BUF_WORDS; ulLoop++)
+    {
+        BINLOG1("fill %u\n", ulLoop);
+    }
+    if(g_sBinLog.ulDropped != BINLOG_BUF_WORDS / 2)
+    {
+        ulErrors++;
+    }
+
+    //
+    // Send the full buffer in frames and start decoding in the middle of
+    // the first one: the decoder must resync on the second frame, report the
+    // dropped records, and decode every record after that.
+    //
+    ulCount = 0;
+    while((ulIdx = BinLogFrameRead(pulStream + ulCount,
+                                   BINLOG_FRAME_HDR + 64)) != 0)
+    {
+        ulCount += ulIdx;
+    }
+    ulErrors += SimDecode(pulStream + 5, ulCount - 5, 1, pcStreamText,
+                          sizeof(pcStreamText));
+    ulLines = 0;
+    for(pcLine = strstr(pcStreamText, "fill "); pcLine;
+        pcLine = strstr(pcLine + 1, "fill "))
+    {
+        ulLines++;
+    }
+    if(strncmp(pcStreamText, "<out of sync, 62 words skipped>\n"
+                             "<256 records dropped>\nfill 32\n", 60) ||
+       (ulLines != (BINLOG_BUF_WORDS / 2) - 32) ||
+       !strstr(pcStreamText, "fill 255\n"))
+    {
+        ulErrors++;
+    }
+    printf("framed stream: %lu words, resynced, %lu records decoded\n",
+           ulCount, ulLines);
+
+    //
+    // Cost of a log call against formatting it.
+    //
+    dLog = 0;
+    for(ulLoop = 0; ulLoop < 100000; ulLoop++)
+    {
+        BinLogRead(pulWords, BINLOG_BUF_WORDS);
+        dStart = SimSeconds();
+        for(ulIdx = 0; ulIdx < BINLOG_BUF_WORDS / 4; ulIdx++)
+        {
+            BINLOG2("T0 tick %u, TAR 0x%08x\n", ulIdx, ulLoop);
+        }
+        dLog += SimSeconds() - dStart;
+    }
+    dStart = SimSeconds();
+    for(ulLoop = 0; ulLoop < 100000 * (BINLOG_BUF_WORDS / 4); ulLoop++)
+    {
+        snprintf(pcText, sizeof(pcText), "T0 tick %u, TAR 0x%08x\n",
+                 (unsigned int)ulLoop, (unsigned int)ulIdx);
+    }
+    dPrintf = SimSeconds() - dStart;
+    printf("BINLOG2 %.1f ns, snprintf %.1f ns on the host\n",
+           dLog * 1e9 / (100000 * (BINLOG_BUF_WORDS / 4)),
+           dPrintf * 1e9 / (100000 * (BINLOG_BUF_WORDS / 4)));
+
+    return(ulErrors ? 1 : 0);
+}
+
+#endif /* HOST_SIM */
@@ -0,0 +1,477 @@
+/**
+ * interrupt latency and jitter monitor (lm3s811)
+ * AN04 runs TIMER0A at 1 Hz and TIMER1A at 2 Hz. Real products run periodic
+ * ISRs at kHz rates, and a PWM update that comes late because of a long
+ * critical section or a higher-priority ISR is invisible until a motor
+ * misbehaves.
+ *
+ * A periodic timer measures its own interrupt latency for free. In 32-bit
+ * periodic mode the counter reaches 0 at the time-out, reloads from
+ * GPTMTAILR on the next clock and keeps counting down, so the first thing
+ * the ISR does is read GPTMTAR, and
+ *
+ *		latency = TAILR - TAR + 1
+ *
+ * is the number of clocks from the time-out to the start of the handler:
+ * exception entry, tail-chaining, time spent behind higher priority ISRs
+ * and with interrupts disabled. Delays of more than one period, TAILR + 1
+ * clocks, alias to a smaller value, since the counter has reloaded again.
+ */
+
+/**
+ * Histograms:
+ * Each monitored interrupt has a histogram with logarithmic buckets: values
+ * below 8 get a bucket each, above that every power of two is split into 8
+ * buckets, so any value is placed within 12.5 %. The bucket of a value is
+ * found with one CLZ and two shifts, constant time in the ISR. Values of
+ * 65536 clocks and more share the last bucket; the exact maximum is kept
+ * separately. p50 and p99 are read at task level by walking the buckets.
+ *
+ * Build with -DHOST_SIM to check the percentiles against exact ones for a
+ * simulated latency distribution; the samples are taken by JitterMonSample()
+ * from a model of the periodic timer, e.g.
+ *		gcc -O2 -DHOST_SIM -x c "AN12_jitter lm3s811.c" -o jitter
+ */
+
+/** Macros for hardware access, both direct and via the bit-band region. */
+#define HWREG(x)	(*((volatile unsigned long *)(x)))
+
+#define JITTER_SUB_BITS		3
+#define JITTER_MAX_BITS		16
+#define JITTER_NUM_BUCKETS                                                   \
+    (((JITTER_MAX_BITS - JITTER_SUB_BITS + 1) << JITTER_SUB_BITS) + 1)
+
+typedef struct
+{
+    unsigned long ulBase;
+    unsigned long ulLoad;
+    unsigned long ulCount;
+    unsigned long ulMax;
+    unsigned long pulBucket[JITTER_NUM_BUCKETS];
+}
+tJitterMon;
+
+#ifndef HOST_SIM
+
+#define JITTER_TIMER_REG(ulBase, ulOffset)	HWREG((ulBase) + (ulOffset))
+
+static inline unsigned long JitterClz(unsigned long ulValue)
+{
+    unsigned long ulCount;
+
+    __asm("clz %0, %1" : "=r" (ulCount) : "r" (ulValue));
+    return(ulCount);
+}
+
+#else /* HOST_SIM */
+
+#define ASSERT(x)
+
+/** On the target these come from inc/hw_timer.h and inc/hw_memmap.h. */
+#define TIMER0_BASE			0x40030000
+#define TIMER_O_TAILR		0x00000028
+#define TIMER_O_TAR			0x00000048
+
+static unsigned long SimTimerRead(unsigned long ulBase,
+                                  unsigned long ulOffset);
+
+#define JITTER_TIMER_REG(ulBase, ulOffset)	SimTimerRead(ulBase, ulOffset)
+
+static inline unsigned long JitterClz(unsigned long ulValue)
+{
+    return(ulValue ? __builtin_clz((unsigned int)ulValue) : 32);
+}
+
+#endif /* HOST_SIM */
+
+/**
+ * JitterBucket() - The histogram bucket of a latency.
+ * @ulValue:		the latency in clocks.
+ *
+ * Return:	the bucket index.
+ */
+static inline unsigned long JitterBucket(unsigned long ulValue)
+{
+    unsigned long ulExp;
+
+    if(ulValue < (1 << JITTER_SUB_BITS))
+    {
+        return(ulValue);
+    }
+    if(ulValue >= (1 << JITTER_MAX_BITS))
+    {
+        return(JITTER_NUM_BUCKETS - 1);
+    }
+
+    ulExp = 31 - JitterClz(ulValue);
+    return(((ulExp - JITTER_SUB_BITS + 1) << JITTER_SUB_BITS) +
+           ((ulValue >> (ulExp - JITTER_SUB_BITS)) &
+            ((1 << JITTER_SUB_BITS) - 1)));
+}
+
+/**
+ * JitterBucketLimit() - The largest latency that falls in a bucket.
+ * @ulBucket:		the bucket index.
+ *
+ * Return:	the upper bound in clocks.
+ */
+static unsigned long JitterBucketLimit(unsigned long ulBucket)
+{
+    unsigned long ulShift;
+
+    if(ulBucket < (1 << JITTER_SUB_BITS))
+    {
+        return(ulBucket);
+    }
+    if(ulBucket == (JITTER_NUM_BUCKETS - 1))
+    {
+        return(~0UL);
+    }
+
+    ulShift = (ulBucket >> JITTER_SUB_BITS) - 1;
+    return((((ulBucket & ((1 << JITTER_SUB_BITS) - 1)) +
+             (1 << JITTER_SUB_BITS) + 1) << ulShift) - 1);
+}
+
+/**
+ * JitterMonInit() - Attaches a monitor to a periodic timer.
+ * @psMon:			the monitor.
+ * @ulBase:			the base address of the timer module; timer A must be
+ *					configured as a 32-bit periodic timer and its load value
+ *					set before this call.
+ *
+ * Return:	none.
+ */
+void JitterMonInit(tJitterMon *psMon, unsigned long ulBase)
+{
+    unsigned long ulIdx;
+
+    psMon->ulBase = ulBase;
+    psMon->ulLoad = JITTER_TIMER_REG(ulBase, TIMER_O_TAILR);
+    psMon->ulCount = 0;
+    psMon->ulMax = 0;
+    for(ulIdx = 0; ulIdx < JITTER_NUM_BUCKETS; ulIdx++)
+    {
+        psMon->pulBucket[ulIdx] = 0;
+    }
+}
+
+/**
+ * JitterMonRecord() - Adds one latency to the histogram.
+ * @psMon:			the monitor.
+ * @ulLatency:		the latency in clocks.
+ *
+ * Return:	none.
+ */
+static inline void JitterMonRecord(tJitterMon *psMon, unsigned long ulLatency)
+{
+    psMon->pulBucket[JitterBucket(ulLatency)]++;
+    psMon->ulCount++;
+    if(ulLatency > psMon->ulMax)
+    {
+        psMon->ulMax = ulLatency;
+    }
+}
+
+/**
+ * JitterMonSample() - Records the latency of the running timer ISR.
+ * @psMon:			the monitor of the timer that interrupted.
+ *
+ * Must be the first thing the ISR does.
+ *
+ * Return:	none.
+ */
+static inline void JitterMonSample(tJitterMon *psMon)
+{
+    JitterMonRecord(psMon, psMon->ulLoad + 1 -
+                           JITTER_TIMER_REG(psMon->ulBase, TIMER_O_TAR));
+}
+
+/**
+ * JitterMonPercentile() - Reads a percentile from the histogram.
+ * @psMon:			the monitor.
+ * @ulPermille:		the percentile in tenths of a percent, 500 for p50.
+ *
+ * The result is the upper bound of the bucket holding the percentile, but no
+ * more than the largest latency seen. Counts added by the ISR during the
+ * walk are either all in or all out of the total it uses.
+ *
+ * Return:	the latency in clocks, 0 if nothing was recorded.
+ */
+unsigned long JitterMonPercentile(tJitterMon *psMon, unsigned long ulPermille)
+{
+    unsigned long pulCopy[JITTER_NUM_BUCKETS];
+    unsigned long ulIdx, ulTotal, ulRank, ulSum, ulLimit;
+
+    ulTotal = 0;
+    for(ulIdx = 0; ulIdx < JITTER_NUM_BUCKETS; ulIdx++)
+    {
+        pulCopy[ulIdx] = psMon->pulBucket[ulIdx];
+        ulTotal += pulCopy[ulIdx];
+    }
+    if(ulTotal == 0)
+    {
+        return(0);
+    }
+
+    //
+    // The rank of the sample at the percentile, rounding up.
+    //
+    ulRank = (unsigned long)(((unsigned long long)ulTotal * ulPermille +
+                              999) / 1000);
+    if(ulRank == 0)
+    {
+        ulRank = 1;
+    }
+
+    ulSum = 0;
+    for(ulIdx = 0; ulIdx < JITTER_NUM_BUCKETS; ulIdx++)
+    {
+        ulSum += pulCopy[ulIdx];
+        if(ulSum >= ulRank)
+        {
+            break;
+        }
+    }
+
+    ulLimit = JitterBucketLimit(ulIdx);
+    return((ulLimit < psMon->ulMax) ? ulLimit : psMon->ulMax);
+}
+
+#ifndef HOST_SIM
+
+static tJitterMon g_sMonTimer0;
+static tJitterMon g_sMonTimer1;
+
+void Timer0AIntHandler(void)
+{
+    JitterMonSample(&g_sMonTimer0);
+    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+}
+
+void Timer1AIntHandler(void)
+{
+    JitterMonSample(&g_sMonTimer1);
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+}
+
+/**
+ * Shows p50/p99/max of one monitor in clocks on a display line.
+ */
+static void JitterMonShow(tJitterMon *psMon, const char *pcName,
+                          unsigned long ulLine)
+{
+    char pcBuffer[24];
+
+    usnprintf(pcBuffer, sizeof(pcBuffer), "%s %u/%u/%u", pcName,
+              JitterMonPercentile(psMon, 500), JitterMonPercentile(psMon, 990),
+              psMon->ulMax);
+    Display96x16x1StringDraw(pcBuffer, 0, ulLine);
+}
+
+/* AN04's two timers at 10 kHz and 20 kHz, watched by the monitor. */
+int main(void)
+{
+    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN |
+                   SYSCTL_XTAL_6MHZ);
+
+    Display96x16x1Init(false);
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    TimerConfigure(TIMER0_BASE, TIMER_CFG_32_BIT_PER);
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_32_BIT_PER);
+    TimerLoadSet(TIMER0_BASE, TIMER_A, SysCtlClockGet() / 10000);
+    TimerLoadSet(TIMER1_BASE, TIMER_A, SysCtlClockGet() / 20000);
+
+    //
+    // The load values are read back here, so after TimerLoadSet().
+    //
+    JitterMonInit(&g_sMonTimer0, TIMER0_BASE);
+    JitterMonInit(&g_sMonTimer1, TIMER1_BASE);
+
+    IntEnable(INT_TIMER0A);
+    IntEnable(INT_TIMER1A);
+    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+    IntMasterEnable();
+    TimerEnable(TIMER0_BASE, TIMER_A);
+    TimerEnable(TIMER1_BASE, TIMER_A);
+
+    while(1)
+    {
+        JitterMonShow(&g_sMonTimer0, "T0", 0);
+        JitterMonShow(&g_sMonTimer1, "T1", 1);
+    }
+}
+
+#else /* HOST_SIM */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SIM_SAMPLES			1000000
+
+static unsigned long g_ulSimSeed = 1;
+
+/**
+ * Periodic timer model:
+ * Timer A of TIMER0 in 32-bit periodic mode, time-outs at every multiple of
+ * load + 1 clocks. The counter is 0 at a time-out, reloads from TAILR on the
+ * next clock and counts down, so r clocks after a time-out it reads
+ * load + 1 - r, and 0 again at r = load + 1.
+ */
+static unsigned long g_ulSimTAILR;
+static unsigned long long g_ullSimNow;
+
+static unsigned long SimTimerRead(unsigned long ulBase,
+                                  unsigned long ulOffset)
+{
+    if((ulBase != TIMER0_BASE) ||
+       ((ulOffset != TIMER_O_TAILR) && (ulOffset != TIMER_O_TAR)))
+    {
+        fprintf(stderr, "unmodelled register 0x%08lx\n", ulBase + ulOffset);
+        exit(2);
+    }
+    if(ulOffset == TIMER_O_TAILR)
+    {
+        return(g_ulSimTAILR);
+    }
+    ulOffset = (unsigned long)(g_ullSimNow % (g_ulSimTAILR + 1ULL));
+    return(ulOffset ? (g_ulSimTAILR + 1 - ulOffset) : 0);
+}
+
+static unsigned long SimRandom(void)
+{
+    g_ulSimSeed = g_ulSimSeed * 1664525UL + 1013904223UL;
+    return((g_ulSimSeed >> 8) & 0xFFFFFF);
+}
+
+/**
+ * Interrupt latency model: 12 clocks of exception entry, a few clocks of
+ * pipeline and flash wait state variation, a higher priority ISR in the way
+ * 5 % of the time, and a long critical section 0.5 % of the time.
+ */
+static unsigned long SimLatency(void)
+{
+    unsigned long ulLatency, ulDice;
+
+    ulLatency = 12 + SimRandom() % 4;
+    ulDice = SimRandom() % 1000;
+    if(ulDice < 50)
+    {
+        ulLatency += 60 + SimRandom() % 200;
+    }
+    if(ulDice < 5)
+    {
+        ulLatency += 1000 + SimRandom() % 4000;
+    }
+    return(ulLatency);
+}
+
+static int SimCompare(const void *pvA, const void *pvB)
+{
+    unsigned long ulA = *(const unsigned long *)pvA;
+    unsigned long ulB = *(const unsigned long *)pvB;
+
+    return((ulA > ulB) - (ulA < ulB));
+}
+
+static double SimSeconds(void)
+{
+    struct timespec sTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return(sTime.tv_sec + sTime.tv_nsec * 1e-9);
+}
+
+/**
+ * SimCheck() - Compares a histogram percentile with the exact one.
+ *
+ * Return:	1 if it is below the exact value or more than 12.5 % above.
+ */
+static unsigned long SimCheck(tJitterMon *psMon, unsigned long *pulSorted,
+                              unsigned long ulPermille, const char *pcName)
+{
+    unsigned long ulExact, ulHist;
+
+    ulExact = pulSorted[(SIM_SAMPLES * ulPermille + 999) / 1000 - 1];
+    ulHist = JitterMonPercentile(psMon, ulPermille);
+    printf("%s exact %5lu histogram %5lu\n", pcName, ulExact, ulHist);
+
+    return((ulHist < ulExact) || (ulHist > ulExact + ulExact / 8));
+}
+
+int main(void)
+{
+    static unsigned long pulSamples[SIM_SAMPLES];
+    static tJitterMon sMon;
+    unsigned long ulIdx, ulErrors, ulLoad;
+    double dStart;
+
+    //
+    // Every value must land in a bucket whose bounds contain it.
+    //
+    ulErrors = 0;
+    for(ulIdx = 0; ulIdx < (1 << JITTER_MAX_BITS); ulIdx++)
+    {
+        if((JitterBucketLimit(JitterBucket(ulIdx)) < ulIdx) ||
+           ((JitterBucket(ulIdx) > 0) &&
+            (JitterBucketLimit(JitterBucket(ulIdx) - 1) >= ulIdx)))
+        {
+            ulErrors++;
+        }
+    }
+
+    //
+    // A 20 kHz timer at 50 MHz. The monitor reads the load value back from
+    // the model; the ISR of time-out n runs SimLatency() clocks after it and
+    // samples TAR. Latencies beyond a period alias, as on the part.
+    //
+    ulLoad = 50000000 / 20000;
+    g_ulSimTAILR = ulLoad;
+    JitterMonInit(&sMon, TIMER0_BASE);
+    if(sMon.ulLoad != ulLoad)
+    {
+        ulErrors++;
+    }
+    for(ulIdx = 0; ulIdx < SIM_SAMPLES; ulIdx++)
+    {
+        pulSamples[ulIdx] = SimLatency();
+    }
+
+    dStart = SimSeconds();
+    for(ulIdx = 0; ulIdx < SIM_SAMPLES; ulIdx++)
+    {
+        g_ullSimNow = (unsigned long long)ulIdx * (ulLoad + 1) +
+                      pulSamples[ulIdx];
+        JitterMonSample(&sMon);
+    }
+    dStart = SimSeconds() - dStart;
+
+    //
+    // A delay of d > 0 clocks reads back as ((d - 1) % (load + 1)) + 1.
+    //
+    for(ulIdx = 0; ulIdx < SIM_SAMPLES; ulIdx++)
+    {
+        pulSamples[ulIdx] = ((pulSamples[ulIdx] - 1) % (ulLoad + 1)) + 1;
+    }
+
+    qsort(pulSamples, SIM_SAMPLES, sizeof(pulSamples[0]), SimCompare);
+    ulErrors += SimCheck(&sMon, pulSamples, 500, "p50");
+    ulErrors += SimCheck(&sMon, pulSamples, 990, "p99");
+    ulErrors += SimCheck(&sMon, pulSamples, 999, "p99.9");
+    printf("max   exact %5lu histogram %5lu\n", pulSamples[SIM_SAMPLES - 1],
+           sMon.ulMax);
+    if(sMon.ulMax != pulSamples[SIM_SAMPLES - 1])
+    {
+        ulErrors++;
+    }
+    printf("%u buckets, %.1f ns per sample on the host\n",
+           JITTER_NUM_BUCKETS, dStart * 1e9 / SIM_SAMPLES);
+
+    return(ulErrors ? 1 : 0);
+}
+
+#endif /* HOST_SIM */